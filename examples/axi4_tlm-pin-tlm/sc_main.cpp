@@ -19,9 +19,17 @@ using namespace sc_core;
 using namespace axi;
 using namespace axi::pe;
 
+// the bus width and the data type of the pin level signals can be set when building the example
+#ifndef AXI_BUSWIDTH
+#define AXI_BUSWIDTH 32
+#endif
+#ifndef AXI_FIXED_BV
+#define AXI_FIXED_BV false
+#endif
+
 class testbench : public sc_core::sc_module {
 public:
-    using bus_cfg = axi::axi4_cfg</*BUSWIDTH=*/32, /*ADDRWIDTH=*/32, /*IDWIDTH=*/4, /*USERWIDTH=*/1>;
+    using bus_cfg = axi::axi4_cfg</*BUSWIDTH=*/AXI_BUSWIDTH, /*ADDRWIDTH=*/32, /*IDWIDTH=*/4, /*USERWIDTH=*/1, /*FIXED_BV=*/AXI_FIXED_BV>;
 
     sc_core::sc_time clk_period{10, sc_core::SC_NS};
     sc_core::sc_clock clk{"clk", clk_period, 0.5, sc_core::SC_ZERO_TIME, true};
@@ -47,7 +55,7 @@ private:
     axi::pe::simple_target<bus_cfg::BUSWIDTH> tgt_pe;
     unsigned id{0};
     unsigned int ResetCycles{10};
-    unsigned int BurstLengthByte{16};
+    unsigned int BurstLengthByte{4 * bus_cfg::BUSWIDTH / 8};
     unsigned int NumberOfIterations{10};
     sc_core::sc_event start_trigger;
     uint8_t resp_cnt{0}, req_cnt{0};
@@ -128,7 +136,7 @@ public:
         req_cnt++;
     }
     void run0() {
-        unsigned int StartAddr{0x20};
+        unsigned int StartAddr{2 * BurstLengthByte};
         rst.write(false);
         for(size_t i = 0; i < ResetCycles; ++i)
             wait(clk.posedge_event());
@@ -162,7 +170,7 @@ public:
     }
 
     void run1() {
-        unsigned int StartAddr{0x1020};
+        unsigned int StartAddr{0x1000 + 2 * BurstLengthByte};
         wait(start_trigger);
         for(int i = 0; i < NumberOfIterations; ++i) {
             SCCDEBUG(SCMOD) << "run1 executing transactions in iteration " << i;
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <scc/fifo_w_cb.h>
+#include <scc/report.h>
+
+using namespace sc_core;
+
+// a producer writes bursts of elements each delta cycle, the consumer drains all visible elements once notified
+class fifo_test : public sc_module {
+public:
+    SC_HAS_PROCESS(fifo_test);
+
+    fifo_test(sc_module_name const& nm, uint64_t elements)
+    : sc_module(nm)
+    , elements(elements) {
+        SC_THREAD(run);
+        SC_THREAD(produce_deque);
+        SC_THREAD(consume_deque);
+        SC_THREAD(produce_ring);
+        SC_THREAD(consume_ring);
+        SC_THREAD(produce_sc_fifo);
+        SC_THREAD(consume_sc_fifo);
+    }
+
+private:
+    static constexpr unsigned burst = 16;
+
+    void run() {
+        measure("fifo_w_cb", start_deque);
+        measure("ring_fifo_w_cb", start_ring);
+        measure("sc_fifo", start_sc_fifo);
+    }
+
+    void measure(char const* name, sc_event& start_evt) {
+        received = 0;
+        sum = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        start_evt.notify();
+        wait(done_evt);
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        if(sum != elements * (elements - 1) / 2)
+            SCCERR(SCMOD) << name << ": wrong checksum " << sum;
+        else
+            SCCINFO(SCMOD) << name << ": " << elements << " elements in " << secs.count() << "s, " << elements / secs.count()
+                           << " elements/s";
+    }
+
+    void consumed(uint64_t v) {
+        sum += v;
+        if(++received == elements)
+            done_evt.notify();
+    }
+
+    void produce_deque() {
+        wait(start_deque);
+        for(uint64_t i = 0; i < elements; ++i) {
+            deque_fifo.push_back(i);
+            if(i % burst == burst - 1)
+                wait(SC_ZERO_TIME);
+        }
+    }
+
+    void consume_deque() {
+        wait(start_deque);
+        while(received < elements) {
+            wait(deque_fifo.data_written_event());
+            for(; !deque_fifo.empty(); deque_fifo.pop_front())
+                consumed(deque_fifo.front());
+        }
+    }
+
+    void produce_ring() {
+        wait(start_ring);
+        for(uint64_t i = 0; i < elements; ++i) {
+            while(!ring_fifo.push_back(i))
+                wait(ring_fifo.data_read_event());
+            if(i % burst == burst - 1)
+                wait(SC_ZERO_TIME);
+        }
+    }
+
+    void consume_ring() {
+        wait(start_ring);
+        while(received < elements) {
+            wait(ring_fifo.data_written_event());
+            for(; !ring_fifo.empty(); ring_fifo.pop_front())
+                consumed(ring_fifo.front());
+        }
+    }
+
+    void produce_sc_fifo() {
+        wait(start_sc_fifo);
+        for(uint64_t i = 0; i < elements; ++i)
+            plain_fifo.write(i);
+    }
+
+    void consume_sc_fifo() {
+        wait(start_sc_fifo);
+        while(received < elements)
+            consumed(plain_fifo.read());
+    }
+
+    uint64_t const elements;
+    uint64_t received{0}, sum{0};
+    sc_event start_deque, start_ring, start_sc_fifo, done_evt;
+    scc::fifo_w_cb<uint64_t> deque_fifo{"deque_fifo"};
+    scc::ring_fifo_w_cb<uint64_t> ring_fifo{"ring_fifo", 4 * burst};
+    sc_core::sc_fifo<uint64_t> plain_fifo{"plain_fifo", 4 * burst};
+};
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    fifo_test top("top", scale * 10000ULL);
+    sc_start();
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <scc/fixed_bv.h>
+#include <scc/report.h>
+#include <util/xoshiro256.h>
+#include <vector>
+
+using namespace sc_core;
+
+namespace {
+struct range {
+    unsigned hi, lo;
+    uint64_t val;
+};
+
+template <unsigned W> std::vector<range> random_ranges(util::xoshiro256ss& rng, size_t count) {
+    std::vector<range> ret(count);
+    for(auto& r : ret) {
+        r.lo = rng() % W;
+        r.hi = r.lo + rng() % std::min(64U, W - r.lo);
+        r.val = rng();
+    }
+    return ret;
+}
+
+template <unsigned W> sc_dt::sc_biguint<W> random_biguint(util::xoshiro256ss& rng) {
+    sc_dt::sc_biguint<W> ret{0};
+    for(unsigned i = 0; i < scc::fixed_bv<W>::word_count; ++i) {
+        auto const hi = std::min(W, 64 * i + 64) - 1;
+        auto const bits = hi - 64 * i + 1;
+        ret.range(hi, 64 * i) = bits == 64 ? rng() : rng() & ((uint64_t(1) << bits) - 1);
+    }
+    return ret;
+}
+// compares scc::fixed_bv with sc_dt::sc_biguint as reference model for range selects and the conversions
+template <unsigned W> bool check(util::xoshiro256ss& rng, unsigned iterations) {
+    for(unsigned i = 0; i < iterations; ++i) {
+        auto ref = random_biguint<W>(rng);
+        scc::fixed_bv<W> v(ref);
+        if(v.to_biguint() != ref || scc::fixed_bv<W>(v.to_biguint()) != v) {
+            SCCERR("fixed_bv_bench") << "fixed_bv<" << W << "> round trip of " << ref.to_string(sc_dt::SC_HEX) << " yields " << v;
+            return false;
+        }
+        for(auto const& r : random_ranges<W>(rng, 16)) {
+            if(v.range(r.hi, r.lo).to_uint64() != ref.range(r.hi, r.lo).to_uint64()) {
+                SCCERR("fixed_bv_bench") << "fixed_bv<" << W << ">.range(" << r.hi << ", " << r.lo << ") of " << v << " differs";
+                return false;
+            }
+            auto const n = r.hi - r.lo + 1;
+            v.range(r.hi, r.lo) = r.val;
+            ref.range(r.hi, r.lo) = n == 64 ? r.val : r.val & ((uint64_t(1) << n) - 1);
+            if(scc::fixed_bv<W>(ref) != v) {
+                SCCERR("fixed_bv_bench") << "writing fixed_bv<" << W << ">.range(" << r.hi << ", " << r.lo << ") yields " << v
+                                         << " instead of " << ref.to_string(sc_dt::SC_HEX);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+double ops_per_s(size_t ops, std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return ops / secs.count();
+}
+// the AXI pin adapters pack the data bytewise, hence mostly 8 bit ranges are selected
+template <unsigned W> void measure(unsigned rounds) {
+    scc::fixed_bv<W> v;
+    sc_dt::sc_biguint<W> ref{0};
+    uint64_t sum{0}, ref_sum{0};
+    auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned r = 0; r < rounds; ++r)
+        for(unsigned i = 0; i < W / 8; ++i) {
+            v.range(8 * i + 7, 8 * i) = r + i;
+            sum += v.range(8 * i + 7, 8 * i).to_uint64();
+        }
+    auto rate = ops_per_s(2UL * rounds * (W / 8), start);
+    start = std::chrono::high_resolution_clock::now();
+    for(unsigned r = 0; r < rounds; ++r)
+        for(unsigned i = 0; i < W / 8; ++i) {
+            ref.range(8 * i + 7, 8 * i) = (r + i) & 0xff;
+            ref_sum += ref.range(8 * i + 7, 8 * i).to_uint64();
+        }
+    auto ref_rate = ops_per_s(2UL * rounds * (W / 8), start);
+    if(sum != ref_sum || scc::fixed_bv<W>(ref) != v)
+        SCCERR("fixed_bv_bench") << "byte wise access of fixed_bv<" << W << "> differs from sc_biguint";
+    else
+        SCCINFO("fixed_bv_bench") << "byte wise access of " << W << " bits: sc_biguint " << ref_rate << " ops/s, fixed_bv " << rate
+                                  << " ops/s";
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    util::xoshiro256ss rng;
+    if(check<64>(rng, 100) && check<100>(rng, 100) && check<128>(rng, 100) && check<512>(rng, 100) && check<1000>(rng, 100))
+        SCCINFO("fixed_bv_bench") << "range selects and conversions match sc_biguint";
+    measure<128>(scale * 1000);
+    measure<512>(scale * 1000);
+    measure<1024>(scale * 1000);
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <scc/report.h>
+#include <scc/utilities.h>
+#include <sys/resource.h>
+#include <vector>
+
+using namespace sc_core;
+// the names of the members each module derives from its hierarchical name during elaboration (trace names, tracing
+// enable parameters, ...)
+static char const* const member_names[] = {"clk_i", "rst_i", "data_o", "valid_o", "ready_i", "enableTracing", "state", "count"};
+
+class leaf : public sc_module {
+public:
+    leaf(sc_module_name const& nm)
+    : sc_module(nm) {}
+};
+
+class cluster : public sc_module {
+public:
+    cluster(sc_module_name const& nm, unsigned leafs)
+    : sc_module(nm) {
+        for(unsigned i = 0; i < leafs; ++i)
+            children.emplace_back(new leaf(sc_gen_unique_name("leaf")));
+    }
+    std::vector<std::unique_ptr<leaf>> children;
+};
+
+static long max_rss_kb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static void collect(sc_object* obj, std::vector<sc_object*>& objs) {
+    objs.push_back(obj);
+    for(auto* child : obj->get_child_objects())
+        collect(child, objs);
+}
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::unique_ptr<cluster>> top;
+    for(unsigned i = 0; i < scale; ++i)
+        top.emplace_back(new cluster(sc_gen_unique_name("cluster"), 64));
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    SCCINFO("interner_bench") << "built " << scale * 65 << " modules in " << secs.count() << "s, max RSS " << max_rss_kb() << "kB";
+    std::vector<sc_object*> objs;
+    for(auto* obj : sc_get_top_level_objects())
+        collect(obj, objs);
+    // before: every member name is concatenated and kept as separate string
+    auto rss = max_rss_kb();
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::string> names;
+    size_t string_bytes = 0;
+    for(auto* obj : objs)
+        for(auto member : member_names) {
+            names.push_back(std::string(obj->name()) + "." + member);
+            string_bytes += sizeof(std::string) + (names.back().capacity() > 15 ? names.back().capacity() + 1 : 0);
+        }
+    secs = std::chrono::high_resolution_clock::now() - start;
+    SCCINFO("interner_bench") << "concatenated " << names.size() << " names in " << secs.count() << "s using " << string_bytes / 1024
+                              << "kB, max RSS grew by " << max_rss_kb() - rss << "kB";
+    // after: the names are interned as children of the interned hierarchical name of the object
+    auto& interner = util::string_interner::get();
+    auto before = interner.get_stats();
+    rss = max_rss_kb();
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<std::string const*> interned;
+    for(auto* obj : objs)
+        for(auto member : member_names)
+            interned.push_back(&scc::hier_name(obj, member));
+    secs = std::chrono::high_resolution_clock::now() - start;
+    auto after = interner.get_stats();
+    SCCINFO("interner_bench") << "interned " << interned.size() << " names in " << secs.count() << "s using "
+                              << (after.bytes - before.bytes) / 1024 << "kB (" << after.symbols - before.symbols << " symbols, "
+                              << after.paths - before.paths << " paths), max RSS grew by " << max_rss_kb() - rss << "kB";
+    for(size_t i = 0; i < names.size(); ++i)
+        if(names[i] != *interned[i]) {
+            SCCERR("interner_bench") << "interned name " << *interned[i] << " differs from " << names[i];
+            break;
+        }
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <scc/report.h>
+#include <util/masked_copy.h>
+#include <vector>
+
+using namespace sc_core;
+
+namespace {
+// the byte by byte copy used before, byte i is enabled by be[(offset + i) % be_len]
+void reference_copy(uint8_t* dst, uint8_t const* src, uint8_t const* be, size_t be_len, size_t offset, size_t len) {
+    for(size_t i = 0; i < len; ++i)
+        if(be[(offset + i) % be_len])
+            dst[i] = src[i];
+}
+
+double gb_per_s(size_t bytes, std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return bytes / secs.count() / (1024.0 * 1024.0 * 1024.0);
+}
+
+void measure(char const* name, std::vector<uint8_t> const& be, size_t len, unsigned rounds) {
+    std::vector<uint8_t> src(len), ref(len), dst(len);
+    for(size_t i = 0; i < len; ++i)
+        src[i] = static_cast<uint8_t>(i * 13 + 7);
+    auto const bytes = len * rounds;
+    auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned r = 0; r < rounds; ++r)
+        reference_copy(ref.data(), src.data(), be.data(), be.size(), r, len);
+    auto ref_rate = gb_per_s(bytes, start);
+    start = std::chrono::high_resolution_clock::now();
+    for(unsigned r = 0; r < rounds; ++r)
+        util::masked_copy(dst.data(), src.data(), be.data(), be.size(), r, len);
+    auto rate = gb_per_s(bytes, start);
+    if(dst != ref)
+        SCCERR("masked_copy_bench") << name << ": masked_copy differs from the byte wise copy";
+    else
+        SCCINFO("masked_copy_bench") << name << " (" << be.size() << " byte enables, " << len << " bytes): byte wise " << ref_rate
+                                     << "GB/s, masked_copy " << rate << "GB/s";
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    auto const rounds = scale * 1000;
+    size_t const len = 4096;
+    std::vector<uint8_t> full(len, 0xff), sparse(len, 0), alternating(len);
+    for(size_t i = 0; i < len; i += 61)
+        sparse[i] = 0xff;
+    for(size_t i = 0; i < len; ++i)
+        alternating[i] = i & 1 ? 0 : 0xff;
+    measure("full", full, len, rounds);
+    measure("sparse", sparse, len, rounds);
+    measure("alternating", alternating, len, rounds);
+    // short patterns repeated over the data, e.g. a 4 byte mask applied to a burst
+    measure("full", std::vector<uint8_t>(4, 0xff), len, rounds);
+    measure("sparse", std::vector<uint8_t>{0xff, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, len, rounds);
+    measure("alternating", std::vector<uint8_t>{0xff, 0}, len, rounds);
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
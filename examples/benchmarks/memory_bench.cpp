@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <scc/memory.h>
+#include <scc/report.h>
+#include <vector>
+
+using namespace sc_core;
+
+namespace {
+double gb_per_s(size_t bytes, std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return bytes / secs.count() / (1024.0 * 1024.0 * 1024.0);
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    size_t const bytes = static_cast<size_t>(scale) << 20;
+    scc::memory<1ULL << 32> mem{"mem"};
+    std::vector<uint8_t> data(bytes);
+    for(size_t i = 0; i < bytes; ++i)
+        data[i] = static_cast<uint8_t>(i * 7 + (i >> 12));
+
+    char const* file_name = "memory_bench.bin";
+    {
+        std::ofstream os(file_name, std::ios::binary);
+        os.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(bytes));
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    if(mem.load_image(file_name, 0x1000) != bytes)
+        SCCERR("memory_bench") << "the image was not loaded completely";
+    SCCINFO("memory_bench") << "load_image of " << scale << "MiB: " << gb_per_s(bytes, start) << "GB/s";
+    std::remove(file_name);
+    if(!mem.compare(0x1000, data.data(), bytes))
+        SCCERR("memory_bench") << "the loaded image differs from the file";
+
+    start = std::chrono::high_resolution_clock::now();
+    mem.write(0x80000000, data.data(), bytes);
+    SCCINFO("memory_bench") << "write of " << scale << "MiB: " << gb_per_s(bytes, start) << "GB/s";
+    std::vector<uint8_t> buf(bytes);
+    start = std::chrono::high_resolution_clock::now();
+    mem.read(0x80000000, buf.data(), bytes);
+    SCCINFO("memory_bench") << "read of " << scale << "MiB: " << gb_per_s(bytes, start) << "GB/s";
+    if(buf != data)
+        SCCERR("memory_bench") << "the read data differs from the written data";
+    start = std::chrono::high_resolution_clock::now();
+    mem.fill(0x40000000, 0xa5, bytes);
+    SCCINFO("memory_bench") << "fill of " << scale << "MiB: " << gb_per_s(bytes, start) << "GB/s";
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
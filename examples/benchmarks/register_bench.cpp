@@ -0,0 +1,191 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <scc/register.h>
+#include <scc/report.h>
+#include <scc/tlm_target.h>
+#include <scc/tlm_target_bfs_register_base.h>
+#include <string>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <vector>
+
+using namespace sc_core;
+
+// a register overriding write(), its accesses must not be executed as direct accesses
+class counting_register : public scc::sc_register<uint32_t> {
+public:
+    using scc::sc_register<uint32_t>::sc_register;
+
+    bool write(const uint8_t* data, size_t length, uint64_t offset, sc_time& d) override {
+        ++writes;
+        return scc::sc_register<uint32_t>::write(data, length, offset, d);
+    }
+
+    static unsigned writes;
+};
+
+unsigned counting_register::writes{0};
+
+// a register bank of 64 32bit registers, the last one has a write callback
+template <typename REG> class reg_bank : public sc_module, public scc::resetable, public scc::tlm_target<> {
+public:
+    static constexpr unsigned count = 64;
+
+    reg_bank(sc_module_name const& nm)
+    : sc_module(nm)
+    , scc::tlm_target<>(clk) {
+        for(unsigned i = 0; i < count; ++i) {
+            regs.emplace_back(new REG(sc_gen_unique_name("reg"), storage[i], 0, *this));
+            addResource(*regs.back(), 4 * i);
+        }
+        regs.back()->set_write_cb([this](scc::sc_register<uint32_t>& reg, uint32_t const& v, sc_time& d) -> bool {
+            reg.put(v);
+            ++writes_seen;
+            return true;
+        });
+    }
+
+    void clear() { storage.fill(0); }
+
+    bool callbacks_seen() const { return writes_seen > 0; }
+
+    sc_time clk{10, SC_NS};
+    std::array<uint32_t, count> storage{};
+    std::vector<std::unique_ptr<REG>> regs;
+    unsigned writes_seen{0};
+};
+
+// a bank of 64 32bit bitfield registers consisting of two 16bit bitfields, if CALLBACKS is set each bitfield has a read
+// and a write callback, otherwise the accesses are handled by the precomputed masks of the registers
+template <bool CALLBACKS> class bitfield_bank : public sc_module, public scc::tlm_target<> {
+public:
+    static constexpr unsigned count = 64;
+
+    bitfield_bank(sc_module_name const& nm)
+    : sc_module(nm)
+    , scc::tlm_target<>(clk) {
+        for(unsigned i = 0; i < count; ++i) {
+            regs.emplace_back(new scc::bitfield_register<uint32_t>(sc_gen_unique_name("reg"), 4 * i));
+            auto& reg = *regs.back();
+            for(unsigned f = 0; f < 2; ++f) {
+                auto name = std::string("BF") + std::to_string(f);
+                fields.emplace_back(new scc::bitfield<uint32_t>(reg, name, 16 * f, 16, std::string(reg.name()) + "." + name));
+                if(CALLBACKS) {
+                    fields.back()->setWriteCallback([this](scc::bitfield<uint32_t>&, uint32_t&) { ++writes_seen; });
+                    fields.back()->setReadCallback([](const scc::bitfield<uint32_t>& bf) { return bf.get(); });
+                }
+            }
+            addResource(reg, 4 * i);
+        }
+    }
+
+    void clear() {
+        for(auto& reg : regs)
+            reg->reset();
+    }
+
+    bool callbacks_seen() const { return !CALLBACKS || writes_seen > 0; }
+
+    sc_time clk{10, SC_NS};
+    std::vector<std::unique_ptr<scc::bitfield_register<uint32_t>>> regs;
+    std::vector<std::unique_ptr<scc::bitfield<uint32_t>>> fields;
+    unsigned writes_seen{0};
+};
+
+template <typename BANK> class register_test : public sc_module {
+public:
+    SC_HAS_PROCESS(register_test);
+
+    tlm_utils::simple_initiator_socket<register_test, scc::LT> isck{"isck"};
+    BANK bank{"bank"};
+    unsigned writes_issued{0};
+
+    register_test(sc_module_name const& nm, unsigned accesses)
+    : sc_module(nm)
+    , accesses(accesses) {
+        isck(bank.socket);
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        std::array<uint8_t, 4> const full{{0xff, 0xff, 0xff, 0xff}}, low{{0xff, 0xff, 0, 0}}, split{{0xff, 0, 0xff, 0}};
+        measure("no byte enables", nullptr, nullptr, 0xffffffff);
+        measure("all bytes enabled", full.data(), full.data(), 0xffffffff);
+        measure("lower half enabled", low.data(), low.data(), 0x0000ffff);
+        // alternating masks defeat any caching of the last classification
+        measure("alternating masks", full.data(), low.data(), 0xffffffff);
+        bank.set_split_byte_enables(true);
+        measure("split byte enables", split.data(), split.data(), 0x00ff00ff);
+        if(!bank.callbacks_seen())
+            SCCERR(SCMOD) << "the write callbacks were never called";
+    }
+
+    void measure(char const* name, uint8_t const* be0, uint8_t const* be1, uint32_t mask) {
+        bank.clear();
+        tlm::tlm_generic_payload gp;
+        uint32_t data{0};
+        gp.set_data_ptr(reinterpret_cast<uint8_t*>(&data));
+        gp.set_data_length(4);
+        gp.set_streaming_width(4);
+        gp.set_byte_enable_length(be0 ? 4 : 0);
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned i = 0; i < accesses; ++i) {
+            sc_time d;
+            auto idx = i % BANK::count;
+            gp.set_command(i & 64 ? tlm::TLM_READ_COMMAND : tlm::TLM_WRITE_COMMAND);
+            gp.set_address(4 * idx);
+            gp.set_byte_enable_ptr(const_cast<uint8_t*>(i & 1 ? be1 : be0));
+            gp.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+            data = i & 64 ? 0 : 0xa5a5a5a5 ^ idx;
+            if(gp.is_write())
+                ++writes_issued;
+            isck->b_transport(gp, d);
+            if(!gp.is_response_ok()) {
+                SCCERR(SCMOD) << name << ": access to register " << idx << " failed with " << gp.get_response_string();
+                return;
+            }
+            if(i & 64 && !(i & 1) && (data & mask) != ((0xa5a5a5a5 ^ idx) & mask)) {
+                SCCERR(SCMOD) << name << ": register " << idx << " reads 0x" << std::hex << data;
+                return;
+            }
+        }
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        SCCINFO(SCMOD) << name << ": " << accesses << " accesses in " << secs.count() << "s, " << accesses / secs.count()
+                       << " accesses/s";
+    }
+
+    unsigned const accesses;
+};
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    // the registers of the second bank override write() and are accessed through the virtual functions
+    register_test<reg_bank<scc::sc_register<uint32_t>>> plain("plain", scale * 10000);
+    register_test<reg_bank<counting_register>> counting("counting", scale * 10000);
+    register_test<bitfield_bank<false>> bitfields("bitfields", scale * 10000);
+    register_test<bitfield_bank<true>> bitfield_callbacks("bitfield_callbacks", scale * 10000);
+    sc_start();
+    if(counting_register::writes < counting.writes_issued)
+        SCCERR("register_bench") << "only " << counting_register::writes << " out of " << counting.writes_issued
+                                 << " writes reached the overridden write()";
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
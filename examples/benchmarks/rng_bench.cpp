@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <scc/mt19937_rng.h>
+#include <scc/report.h>
+#include <vector>
+
+using namespace sc_core;
+
+class rng_test : public sc_module {
+public:
+    SC_HAS_PROCESS(rng_test);
+
+    rng_test(sc_module_name const& nm, size_t calls)
+    : sc_module(nm)
+    , calls(calls) {
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        std::vector<uint64_t> ref(calls), res(calls);
+        // the engines of the process are created before seeding, so both sequences start from the same seed
+        auto rng = scc::MT19937::get_handle();
+        auto fast_rng = scc::MT19937::get_fast_handle();
+        scc::MT19937::seed(42);
+        auto start = std::chrono::high_resolution_clock::now();
+        for(size_t i = 0; i < calls; ++i)
+            ref[i] = scc::MT19937::uniform();
+        report("static uniform()", start);
+        scc::MT19937::seed(42);
+        start = std::chrono::high_resolution_clock::now();
+        for(size_t i = 0; i < calls; ++i)
+            res[i] = rng.uniform();
+        report("handle uniform()", start);
+        if(res != ref)
+            SCCERR(SCMOD) << "the handle yields a different sequence than the static functions";
+        start = std::chrono::high_resolution_clock::now();
+        for(size_t i = 0; i < calls; ++i)
+            res[i] = fast_rng.uniform();
+        report("fast handle uniform()", start);
+
+        std::vector<double> d(calls);
+        start = std::chrono::high_resolution_clock::now();
+        for(size_t i = 0; i < calls; ++i)
+            d[i] = scc::MT19937::normal();
+        report("static normal()", start);
+        start = std::chrono::high_resolution_clock::now();
+        rng.fill_normal(d.data(), calls);
+        report("handle fill_normal()", start);
+
+        std::vector<uint8_t> bytes(calls * 8);
+        start = std::chrono::high_resolution_clock::now();
+        rng.fill_bytes(bytes.data(), bytes.size());
+        report("handle fill_bytes() per 8 bytes", start);
+        start = std::chrono::high_resolution_clock::now();
+        fast_rng.fill_bytes(bytes.data(), bytes.size());
+        report("fast handle fill_bytes() per 8 bytes", start);
+    }
+
+    void report(char const* name, std::chrono::high_resolution_clock::time_point start) {
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        SCCINFO(SCMOD) << name << ": " << calls << " calls in " << secs.count() << "s, " << calls / secs.count() << " calls/s";
+    }
+
+    size_t const calls;
+};
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    rng_test top("top", scale * 100000);
+    sc_start();
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <scc/ordered_semaphore.h>
+#include <scc/report.h>
+
+using namespace sc_core;
+
+// 2 to 64 processes compete for a single token, each holds it for a delta cycle. The number of acquisitions is the
+// same for each number of waiters. An ordered semaphore has to serve the waiters round robin, hence a process never gets
+// the token twice in a row.
+class semaphore_test : public sc_module {
+public:
+    SC_HAS_PROCESS(semaphore_test);
+
+    semaphore_test(sc_module_name const& nm, unsigned acquisitions)
+    : sc_module(nm)
+    , acquisitions(acquisitions) {
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        for(unsigned waiters = 2; waiters <= 64; waiters *= 2) {
+            measure("ordered_semaphore", ordered_sem, waiters);
+            measure("sc_semaphore", plain_sem, waiters);
+        }
+    }
+
+    void measure(char const* name, sc_semaphore_if& sem, unsigned waiters) {
+        auto const per_waiter = std::max(1U, acquisitions / waiters);
+        active = waiters;
+        acquired = 0;
+        repeated = 0;
+        last_owner = waiters;
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned i = 0; i < waiters; ++i)
+            sc_spawn([this, &sem, per_waiter, i]() {
+                for(unsigned k = 0; k < per_waiter; ++k) {
+                    sem.wait();
+                    ++acquired;
+                    if(last_owner == i)
+                        ++repeated;
+                    last_owner = i;
+                    wait(SC_ZERO_TIME);
+                    sem.post();
+                }
+                if(--active == 0)
+                    done_evt.notify();
+            });
+        wait(done_evt);
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        if(acquired != per_waiter * waiters || sem.get_value() != 1)
+            SCCERR(SCMOD) << name << " with " << waiters << " waiters: " << acquired << " acquisitions, final value " << sem.get_value();
+        else if(&sem == &ordered_sem && repeated)
+            SCCERR(SCMOD) << name << " with " << waiters << " waiters: " << repeated << " acquisitions out of order";
+        else
+            SCCINFO(SCMOD) << name << " with " << waiters << " waiters: " << acquired << " acquisitions in " << secs.count() << "s, "
+                           << acquired / secs.count() << " acquisitions/s, " << repeated << " repeated by the same process";
+    }
+
+    unsigned const acquisitions;
+    unsigned active{0}, acquired{0}, repeated{0}, last_owner{0};
+    sc_event done_evt;
+    scc::ordered_semaphore ordered_sem{"ordered_sem", 1};
+    sc_core::sc_semaphore plain_sem{"plain_sem", 1};
+};
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    semaphore_test top("top", scale * 1000);
+    sc_start();
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <scc/report.h>
+#include <stdexcept>
+#include <util/sparse_array.h>
+#include <util/sparse_array_io.h>
+#include <util/xoshiro256.h>
+
+using namespace sc_core;
+
+namespace {
+using array_type = util::sparse_array<uint8_t, 1ULL << 32, 20>;
+
+double mb_per_s(size_t bytes, std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    return bytes / secs.count() / (1024.0 * 1024.0);
+}
+// memory images are partly compressible: the pages alternate between random data, code like patterns and zeros
+void fill(array_type& arr, unsigned pages) {
+    util::xoshiro256ss rng;
+    for(unsigned nr = 0; nr < pages; ++nr) {
+        auto& page = arr(nr * 3);
+        for(size_t i = 0; i < page.size(); i += 8) {
+            auto v = nr % 3 == 0 ? rng() : nr % 3 == 1 ? 0x0000a023000000b7ULL + (i & 0xff0) : 0;
+            for(size_t j = 0; j < 8; ++j)
+                page[i + j] = static_cast<uint8_t>(v >> (8 * j));
+        }
+    }
+}
+
+bool equal(array_type& a, array_type& b, unsigned pages) {
+    for(unsigned nr = 0; nr < pages * 3; ++nr) {
+        auto pa = a.get_page(nr);
+        auto pb = b.get_page(nr);
+        if((pa == nullptr) != (pb == nullptr) || (pa && *pa != *pb))
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    auto const pages = 2 * scale;
+    auto const bytes = static_cast<size_t>(pages) << 20;
+    std::unique_ptr<array_type> mem(new array_type), copy(new array_type);
+    fill(*mem, pages);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto snap = mem->snapshot();
+    copy->restore(snap);
+    SCCINFO("snapshot_bench") << "in-memory snapshot and restore of " << (bytes >> 20) << "MiB: " << mb_per_s(bytes, start) << "MiB/s";
+    start = std::chrono::high_resolution_clock::now();
+    for(unsigned nr = 0; nr < pages; ++nr)
+        (*copy)(nr * 3)[0] ^= 1; // unshares the pages
+    SCCINFO("snapshot_bench") << "copy on write of " << (bytes >> 20) << "MiB: " << mb_per_s(bytes, start) << "MiB/s";
+
+    char const* file_name = "snapshot_bench.snap";
+    start = std::chrono::high_resolution_clock::now();
+    util::save_snapshot(*mem, file_name);
+    SCCINFO("snapshot_bench") << "save_snapshot of " << (bytes >> 20) << "MiB: " << mb_per_s(bytes, start) << "MiB/s";
+    start = std::chrono::high_resolution_clock::now();
+    util::load_snapshot(*copy, file_name);
+    for(unsigned nr = 0; nr < pages * 3; ++nr)
+        copy->get_page(nr);
+    SCCINFO("snapshot_bench") << "load_snapshot of " << (bytes >> 20) << "MiB: " << mb_per_s(bytes, start) << "MiB/s";
+    std::remove(file_name);
+    if(!equal(*mem, *copy, pages))
+        SCCERR("snapshot_bench") << "the restored array differs from the original one";
+
+    snap.emplace_back(copy->page_count, snap.front().second);
+    try {
+        copy->restore(snap);
+        SCCERR("snapshot_bench") << "restoring a page outside of the array was not rejected";
+    } catch(std::runtime_error& e) {
+        if(!equal(*mem, *copy, pages))
+            SCCERR("snapshot_bench") << "a rejected restore modified the array";
+    }
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
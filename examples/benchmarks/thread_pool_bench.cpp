@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <scc/report.h>
+#include <scc/sc_thread_pool.h>
+
+using namespace sc_core;
+using stack_class = scc::sc_thread_pool::stack_class;
+
+class pool_test : public sc_module {
+public:
+    SC_HAS_PROCESS(pool_test);
+
+    pool_test(sc_module_name const& nm, unsigned tasks)
+    : sc_module(nm)
+    , tasks(tasks) {
+        SC_THREAD(run);
+    }
+
+private:
+    void run() {
+        mixed_classes_at_limit();
+        throughput();
+    }
+    // the limit is reached with threads of the small class, the tasks of the larger classes need to be run nevertheless
+    void mixed_classes_at_limit() {
+        pool.max_concurrent_threads.set_value(2);
+        for(unsigned i = 0; i < 2; ++i)
+            pool.execute([this]() { task(); }, stack_class::SMALL);
+        pool.execute([this]() { task(); }, stack_class::LARGE);
+        pool.execute([this]() { task(); }, stack_class::DEFAULT);
+        pool.execute([this]() { task(); }, stack_class::SMALL);
+        wait(100, SC_NS);
+        if(done != 5)
+            SCCERR(SCMOD) << "only " << done << " out of 5 tasks of mixed classes finished";
+        else
+            SCCINFO(SCMOD) << "all tasks of mixed classes finished at the thread limit";
+    }
+
+    void throughput() {
+        pool.max_concurrent_threads.set_value(16);
+        done = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned i = 0; i < tasks; ++i) {
+            pool.execute([this]() { task(); }, static_cast<stack_class>(i % 3));
+            if(i % 64 == 63)
+                wait(10, SC_NS);
+        }
+        while(done < tasks)
+            wait(10, SC_NS);
+        std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+        SCCINFO(SCMOD) << tasks << " tasks in " << secs.count() << "s, " << tasks / secs.count() << " tasks/s, "
+                       << pool.threads_spawned.get_value() << " threads";
+    }
+
+    void task() {
+        wait(10, SC_NS);
+        done++;
+    }
+
+    scc::sc_thread_pool pool;
+    unsigned const tasks;
+    unsigned done{0};
+};
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    pool_test top("top", scale * 1000);
+    sc_start();
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <scc/report.h>
+#include <util/thread_pool.h>
+#include <util/work_stealing_pool.h>
+#include <vector>
+
+using namespace sc_core;
+
+namespace {
+// a small amount of work per task so that the scheduling overhead dominates
+inline void work(std::atomic<uint64_t>& sum, uint64_t seed) {
+    uint64_t v = seed;
+    for(unsigned i = 0; i < 64; ++i)
+        v = v * 6364136223846793005ULL + 1442695040888963407ULL;
+    sum.fetch_add(v & 0xff, std::memory_order_relaxed);
+}
+
+inline uint64_t expected(size_t tasks) {
+    std::atomic<uint64_t> sum{0};
+    for(size_t i = 0; i < tasks; ++i)
+        work(sum, i);
+    return sum.load();
+}
+
+void report(char const* name, size_t tasks, std::chrono::high_resolution_clock::time_point start, uint64_t sum, uint64_t ref) {
+    std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - start;
+    if(sum != ref)
+        SCCERR("work_stealing_bench") << name << ": wrong result " << sum << " instead of " << ref;
+    else
+        SCCINFO("work_stealing_bench") << name << ": " << tasks << " tasks in " << secs.count() << "s, " << tasks / secs.count()
+                                       << " tasks/s";
+}
+} // namespace
+
+int sc_main(int argc, char* argv[]) {
+    scc::init_logging(scc::LogConfig().logLevel(scc::log::INFO));
+    unsigned scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100;
+    size_t const tasks = scale * 10000;
+    auto const threads = std::max(1U, std::thread::hardware_concurrency());
+    auto const ref = expected(tasks);
+    {
+        util::thread_pool pool;
+        pool.start(threads);
+        std::atomic<uint64_t> sum{0};
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::future<void>> results;
+        results.reserve(tasks);
+        for(size_t i = 0; i < tasks; ++i)
+            results.push_back(pool.enqueue([&sum, i]() { work(sum, i); }));
+        for(auto& r : results)
+            r.wait();
+        report("thread_pool", tasks, start, sum.load(), ref);
+    }
+    {
+        util::work_stealing_pool pool(threads);
+        std::atomic<uint64_t> sum{0};
+        auto start = std::chrono::high_resolution_clock::now();
+        for(size_t i = 0; i < tasks; ++i)
+            pool.execute([&sum, i]() { work(sum, i); });
+        pool.wait();
+        report("work_stealing_pool, external submission", tasks, start, sum.load(), ref);
+    }
+    {
+        // the tasks are submitted by the workers themselves and go to their deques
+        util::work_stealing_pool pool(threads);
+        std::atomic<uint64_t> sum{0};
+        size_t const chunk = 1000;
+        auto start = std::chrono::high_resolution_clock::now();
+        for(size_t c = 0; c < tasks; c += chunk)
+            pool.execute([&pool, &sum, c, chunk, tasks]() {
+                for(size_t i = c; i < std::min(tasks, c + chunk); ++i)
+                    pool.execute([&sum, i]() { work(sum, i); });
+            });
+        pool.wait();
+        report("work_stealing_pool, worker submission", tasks, start, sum.load(), ref);
+    }
+    {
+        util::work_stealing_pool pool(threads);
+        std::atomic<uint64_t> sum{0};
+        auto start = std::chrono::high_resolution_clock::now();
+        pool.parallel_for(0, tasks, [&sum](size_t i) { work(sum, i); }, 1);
+        report("work_stealing_pool, parallel_for", tasks, start, sum.load(), ref);
+    }
+    return sc_report_handler::get_count(SC_ERROR) ? 1 : 0;
+}
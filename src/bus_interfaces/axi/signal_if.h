@@ -17,6 +17,7 @@
 #ifndef _BUS_AXI_SIGNAL_IF_H_
 #define _BUS_AXI_SIGNAL_IF_H_
 
+#include <scc/fixed_bv.h>
 #include <scc/signal_opt_ports.h>
 #include <systemc>
 
@@ -71,8 +72,18 @@ struct signal_types {
 
 template <bool Cond, class T, class S> struct select_if { typedef S type; };
 template <class T, class S> struct select_if<true, T, S> { typedef T type; };
+/**
+ * @brief selects the type of the data signals: sc_uint for up to 64 bits, wider busses use sc_biguint or, if
+ * FIXED_BV is set, scc::fixed_bv which avoids the arbitrary precision arithmetic
+ */
+template <unsigned int WIDTH, bool FIXED_BV = false>
+using data_type_t =
+    typename select_if<WIDTH <= 64, sc_dt::sc_uint<WIDTH>,
+                       typename select_if<FIXED_BV, scc::fixed_bv<WIDTH>, sc_dt::sc_biguint<WIDTH>>::type>::type;
 
-template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32, unsigned int IDWDTH = 32, unsigned int USERWDTH = 1> struct axi4_cfg {
+template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32, unsigned int IDWDTH = 32, unsigned int USERWDTH = 1,
+          bool FIXED_BV = false>
+struct axi4_cfg {
     static_assert(BUSWDTH > 0, "BUSWIDTH shall be larger than 0");
     static_assert(ADDRWDTH > 0, "ADDRWDTH shall be larger than 0");
     static_assert(IDWDTH > 0, "IDWDTH shall be larger than 0");
@@ -81,12 +92,12 @@ template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32, unsigned int ID
     constexpr static unsigned int ADDRWIDTH = ADDRWDTH;
     constexpr static unsigned int IDWIDTH = IDWDTH;
     constexpr static unsigned int USERWIDTH = USERWDTH;
-    using data_t = typename select_if<BUSWDTH <= 64, sc_dt::sc_uint<BUSWIDTH>, sc_dt::sc_biguint<BUSWIDTH>>::type;
+    using data_t = data_type_t<BUSWDTH, FIXED_BV>;
     using slave_types = ::axi::slave_types;
     using master_types = ::axi::master_types;
 };
 
-template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32> struct axi4_lite_cfg {
+template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32, bool FIXED_BV = false> struct axi4_lite_cfg {
     static_assert(BUSWDTH > 0, "BUSWIDTH shall be larger than 0");
     static_assert(ADDRWDTH > 0, "ADDRWDTH shall be larger than 0");
     constexpr static bool IS_LITE = true;
@@ -94,7 +105,7 @@ template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32> struct axi4_lit
     constexpr static unsigned int ADDRWIDTH = ADDRWDTH;
     constexpr static unsigned int IDWIDTH = 0;
     constexpr static unsigned int USERWIDTH = 1;
-    using data_t = typename select_if<BUSWDTH <= 64, sc_dt::sc_uint<BUSWIDTH>, sc_dt::sc_biguint<BUSWIDTH>>::type;
+    using data_t = data_type_t<BUSWDTH, FIXED_BV>;
     using slave_types = ::axi::lite_slave_types;
     using master_types = ::axi::lite_master_types;
 };
@@ -107,9 +118,10 @@ template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32> struct axi4_lit
  * @tparam IDWDTH
  * @tparam USERWDTH
  * @tparam CACHELINE: cacheline size in Bytes, defaults value is 64 bytes
+ * @tparam FIXED_BV use scc::fixed_bv instead of sc_dt::sc_biguint for data busses wider than 64 bits
  */
 template <unsigned int BUSWDTH = 32, unsigned int ADDRWDTH = 32, unsigned int IDWDTH = 32, unsigned int USERWDTH = 1,
-          unsigned int AWSNOOPWDTH = 3, unsigned int RESPWDTH = 4>
+          unsigned int AWSNOOPWDTH = 3, unsigned int RESPWDTH = 4, bool FIXED_BV = false>
 struct ace_cfg {
 
     static_assert(BUSWDTH > 0, "BUSWIDTH shall be larger than 0");
@@ -123,7 +135,7 @@ struct ace_cfg {
     constexpr static unsigned int USERWIDTH = USERWDTH;
     constexpr static unsigned int AWSNOOPWIDTH = AWSNOOPWDTH;
     constexpr static unsigned int RESPWIDTH = RESPWDTH;
-    using data_t = typename select_if<BUSWDTH <= 64, sc_dt::sc_uint<BUSWIDTH>, sc_dt::sc_biguint<BUSWIDTH>>::type;
+    using data_t = data_type_t<BUSWDTH, FIXED_BV>;
     using slave_types = ::axi::slave_types;
     using master_types = ::axi::master_types;
 };
@@ -26,15 +26,24 @@
 #ifndef _MSC_VER
 #include "util/delegate.h"
 #endif
+#include "util/hdr_histogram.h"
 #include "util/io-redirector.h"
+#include "util/image_loader.h"
 #include "util/ities.h"
 #include "util/logging.h"
+#include "util/masked_copy.h"
+#include "util/mem_fill.h"
+#include "util/mpsc_queue.h"
 #include "util/mt19937_rng.h"
 #include "util/pool_allocator.h"
 #include "util/range_lut.h"
+#include "util/small_task.h"
 #include "util/sparse_array.h"
+#include "util/string_interner.h"
 #include "util/strprintf.h"
 #include "util/thread_syncronizer.h"
 #include "util/watchdog.h"
+#include "util/work_stealing_pool.h"
+#include "util/xoshiro256.h"
 #include <util/sccassert.h>
 /**@}*/
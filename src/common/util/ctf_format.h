@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_CTF_FORMAT_H_
+#define _UTIL_CTF_FORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * The columnar trace format (CTF) stores the value changes of each signal in time chunked columns. Each column block
+ * holds the changes of one signal within one chunk and is LZ4 compressed independently. The file layout is:
+ *
+ *   magic | block* | footer | footer offset (8 byte little endian) | magic
+ *
+ * The footer contains the signal table and the block index (signal, chunk, first and last time stamp, file offset,
+ * compressed and raw size, number of changes) so that a reader can locate the blocks of a signal subset or a time
+ * slice without decompressing anything else. All integers in the footer and in the blocks are LEB128 encoded.
+ * A block contains per change the time delta to the previous change (the first one relative to the first time stamp
+ * of the block) followed by the value: a LEB128 encoded integer for UINT, 8 bytes for REAL and one character per bit
+ * (MSB first) for LOGIC signals.
+ */
+namespace util {
+namespace ctf {
+//! the file magic at the beginning and the end of a file
+constexpr char magic[8] = {'S', 'C', 'C', 'C', 'T', 'F', '0', '1'};
+//! the value encoding of a signal
+enum kind : uint8_t {
+    UINT,  //!< two state values up to 64 bit
+    LOGIC, //!< four state or wide values stored as character string
+    REAL   //!< floating point values
+};
+//! \brief the value of a signal in its decoded form
+struct value {
+    kind type{UINT};
+    uint64_t u{0};
+    double r{0.};
+    std::string s;
+};
+//! \brief appends a LEB128 encoded integer
+inline void put_varint(std::string& buf, uint64_t v) {
+    while(v >= 0x80) {
+        buf.push_back(static_cast<char>((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    buf.push_back(static_cast<char>(v));
+}
+//! \brief reads a LEB128 encoded integer and advances the pointer, returns false if the buffer end is reached
+inline bool get_varint(char const*& p, char const* end, uint64_t& v) {
+    v = 0;
+    for(unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        auto c = static_cast<uint8_t>(*p++);
+        v |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if(!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+//! \brief appends a length prefixed string
+inline void put_string(std::string& buf, std::string const& s) {
+    put_varint(buf, s.size());
+    buf.append(s);
+}
+//! \brief reads a length prefixed string and advances the pointer
+inline bool get_string(char const*& p, char const* end, std::string& s) {
+    uint64_t len;
+    if(!get_varint(p, end, len) || len > static_cast<uint64_t>(end - p))
+        return false;
+    s.assign(p, len);
+    p += len;
+    return true;
+}
+} // namespace ctf
+} // namespace util
+#endif /* _UTIL_CTF_FORMAT_H_ */
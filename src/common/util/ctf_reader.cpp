@@ -0,0 +1,272 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "ctf_reader.h"
+#include <algorithm>
+#include <iomanip>
+#include <lz4.h>
+#include <map>
+#include <unordered_map>
+
+namespace util {
+
+ctf_reader::ctf_reader(std::string const& name)
+: in(name, std::ios::binary) {
+    if(!in.is_open())
+        return;
+    in.seekg(0, std::ios::end);
+    uint64_t size = in.tellg();
+    if(size < 2 * sizeof(ctf::magic) + 8)
+        return;
+    char head[sizeof(ctf::magic)], tail[8 + sizeof(ctf::magic)];
+    in.seekg(0);
+    in.read(head, sizeof(head));
+    in.seekg(size - sizeof(tail));
+    in.read(tail, sizeof(tail));
+    if(!in || memcmp(head, ctf::magic, sizeof(ctf::magic)) || memcmp(tail + 8, ctf::magic, sizeof(ctf::magic)))
+        return;
+    uint64_t footer_offs = 0;
+    for(auto i = 0U; i < 8; ++i)
+        footer_offs |= static_cast<uint64_t>(static_cast<uint8_t>(tail[i])) << (8 * i);
+    if(footer_offs < sizeof(ctf::magic) || footer_offs > size - sizeof(tail))
+        return;
+    std::string footer(size - sizeof(tail) - footer_offs, '\0');
+    in.seekg(footer_offs);
+    in.read(&footer[0], footer.size());
+    if(!in)
+        return;
+    char const* p = footer.data();
+    char const* end = p + footer.size();
+    uint64_t count, val[8];
+    if(!ctf::get_varint(p, end, count))
+        return;
+    signals.resize(count);
+    for(auto& s : signals) {
+        if(!ctf::get_string(p, end, s.name) || p == end)
+            return;
+        s.type = static_cast<ctf::kind>(*p++);
+        if(!ctf::get_varint(p, end, val[0]) || !ctf::get_varint(p, end, val[1]) || val[1] > count)
+            return;
+        s.bits = val[0];
+        s.alias_of = static_cast<int>(val[1]) - 1;
+    }
+    if(!ctf::get_varint(p, end, count))
+        return;
+    blocks.reserve(count);
+    signal_blocks.resize(signals.size());
+    for(auto i = 0U; i < count; ++i) {
+        for(auto& v : val)
+            if(!ctf::get_varint(p, end, v))
+                return;
+        if(val[0] >= signals.size())
+            return;
+        blocks.push_back(block{static_cast<unsigned>(val[0]), val[1], val[2], val[3], val[4], static_cast<uint32_t>(val[5]),
+                               static_cast<uint32_t>(val[6]), static_cast<uint32_t>(val[7])});
+        signal_blocks[val[0]].push_back(blocks.size() - 1);
+        end_time = std::max(end_time, val[3]);
+    }
+    valid = true;
+}
+
+int ctf_reader::find_signal(std::string const& name) const {
+    auto it = std::find_if(std::begin(signals), std::end(signals), [&name](signal const& s) { return s.name == name; });
+    return it == std::end(signals) ? -1 : std::distance(std::begin(signals), it);
+}
+
+bool ctf_reader::decode(block const& b, unsigned id, std::vector<change>& res) {
+    comp_buf.resize(b.comp_size);
+    raw_buf.resize(b.raw_size);
+    in.clear();
+    in.seekg(b.offset);
+    in.read(&comp_buf[0], b.comp_size);
+    if(!in || LZ4_decompress_safe(comp_buf.data(), &raw_buf[0], b.comp_size, b.raw_size) != static_cast<int>(b.raw_size))
+        return false;
+    auto const& sig = signals[b.signal];
+    char const* p = raw_buf.data();
+    char const* end = p + raw_buf.size();
+    uint64_t time = b.first_time, delta;
+    for(auto i = 0U; i < b.count; ++i) {
+        if(!ctf::get_varint(p, end, delta))
+            return false;
+        time += delta;
+        res.push_back(change{time, id, ctf::value{}});
+        auto& v = res.back().val;
+        v.type = sig.type;
+        switch(sig.type) {
+        case ctf::UINT:
+            if(!ctf::get_varint(p, end, v.u))
+                return false;
+            break;
+        case ctf::REAL:
+            if(end - p < static_cast<ptrdiff_t>(sizeof(double)))
+                return false;
+            memcpy(&v.r, p, sizeof(double));
+            p += sizeof(double);
+            break;
+        default:
+            if(end - p < static_cast<ptrdiff_t>(sig.bits))
+                return false;
+            v.s.assign(p, sig.bits);
+            p += sig.bits;
+            break;
+        }
+    }
+    return true;
+}
+
+bool ctf_reader::read(std::vector<unsigned> const& ids, callback cb, uint64_t from, uint64_t to) {
+    if(!valid)
+        return false;
+    // map the base signals to the requested ids referring to them
+    std::map<unsigned, std::vector<unsigned>> requested;
+    for(auto id : ids) {
+        if(id >= signals.size())
+            return false;
+        auto base = signals[id].alias_of < 0 ? id : static_cast<unsigned>(signals[id].alias_of);
+        requested[base].push_back(id);
+    }
+    auto report = [&requested, &cb](change const& c) {
+        for(auto id : requested[c.id])
+            cb(c.time, id, c.val);
+    };
+    std::vector<change> changes;
+    std::map<uint64_t, std::vector<size_t>> chunks;
+    for(auto& e : requested) {
+        auto& sb = signal_blocks[e.first];
+        // the value at the start of the slice comes from the last block starting not after it
+        auto it = std::upper_bound(std::begin(sb), std::end(sb), from,
+                                   [this](uint64_t t, size_t idx) { return t < blocks[idx].first_time; });
+        if(it != std::begin(sb)) {
+            changes.clear();
+            if(!decode(blocks[*std::prev(it)], e.first, changes))
+                return false;
+            auto last = std::find_if(changes.rbegin(), changes.rend(), [from](change const& c) { return c.time <= from; });
+            if(last != changes.rend()) {
+                last->time = from;
+                report(*last);
+            }
+        }
+        for(auto idx : sb)
+            if(blocks[idx].last_time > from && blocks[idx].first_time <= to)
+                chunks[blocks[idx].chunk].push_back(idx);
+    }
+    for(auto& chunk : chunks) {
+        changes.clear();
+        for(auto idx : chunk.second)
+            if(!decode(blocks[idx], blocks[idx].signal, changes))
+                return false;
+        std::stable_sort(std::begin(changes), std::end(changes), [](change const& a, change const& b) { return a.time < b.time; });
+        for(auto& c : changes)
+            if(c.time > from && c.time <= to)
+                report(c);
+    }
+    return true;
+}
+
+namespace {
+struct vcd_scope {
+    std::vector<std::pair<std::string, unsigned>> vars;
+    std::map<std::string, vcd_scope> scopes;
+
+    void write(std::ostream& os, std::vector<ctf_reader::signal> const& signals, std::vector<std::string> const& codes) const {
+        for(auto& v : vars) {
+            auto& s = signals[v.second];
+            os << "$var " << (s.type == ctf::REAL ? "real" : "wire") << " " << (s.type == ctf::REAL ? 64 : s.bits) << " "
+               << codes[v.second] << " " << v.first << " $end\n";
+        }
+        for(auto& s : scopes) {
+            os << "$scope module " << s.first << " $end\n";
+            s.second.write(os, signals, codes);
+            os << "$upscope $end\n";
+        }
+    }
+};
+
+std::string vcd_code(unsigned id) {
+    std::string res;
+    do {
+        res.push_back(static_cast<char>('!' + id % 94));
+        id /= 94;
+    } while(id);
+    return res;
+}
+} // namespace
+
+bool ctf_to_vcd(ctf_reader& reader, std::ostream& os, std::vector<std::string> const& names, uint64_t from, uint64_t to) {
+    auto& signals = reader.get_signals();
+    std::vector<unsigned> selected;
+    if(names.empty()) {
+        for(auto i = 0U; i < signals.size(); ++i)
+            selected.push_back(i);
+    } else
+        for(auto& n : names) {
+            auto id = reader.find_signal(n);
+            if(id < 0)
+                return false;
+            selected.push_back(id);
+        }
+    // aliases share the identifier code of the signal they refer to, only the latter one is read
+    std::vector<std::string> codes(signals.size());
+    std::vector<unsigned> ids;
+    vcd_scope root;
+    for(auto id : selected) {
+        auto base = signals[id].alias_of < 0 ? id : static_cast<unsigned>(signals[id].alias_of);
+        if(codes[base].empty()) {
+            codes[base] = vcd_code(base);
+            ids.push_back(base);
+        }
+        codes[id] = codes[base];
+        auto* scope = &root;
+        auto& name = signals[id].name;
+        size_t start = 0, pos;
+        while((pos = name.find('.', start)) != std::string::npos) {
+            scope = &scope->scopes[name.substr(start, pos - start)];
+            start = pos + 1;
+        }
+        scope->vars.emplace_back(name.substr(start), id);
+    }
+    os << "$timescale 1 ps $end\n";
+    root.write(os, signals, codes);
+    os << "$enddefinitions $end\n";
+    uint64_t last_time = std::numeric_limits<uint64_t>::max();
+    auto res = reader.read(
+        ids,
+        [&os, &codes, &signals, &last_time](uint64_t time, unsigned id, ctf::value const& v) {
+            if(time != last_time) {
+                os << "#" << time << "\n";
+                last_time = time;
+            }
+            auto& s = signals[id];
+            switch(v.type) {
+            case ctf::UINT:
+                if(s.bits == 1)
+                    os << (v.u & 1) << codes[id] << "\n";
+                else {
+                    os << "b";
+                    auto bits = s.bits > 64 ? 64 : s.bits;
+                    auto msb = bits;
+                    while(msb > 1 && !((v.u >> (msb - 1)) & 1))
+                        --msb;
+                    for(auto i = msb; i > 0; --i)
+                        os << ((v.u >> (i - 1)) & 1);
+                    os << " " << codes[id] << "\n";
+                }
+                break;
+            case ctf::REAL:
+                os << "r" << std::setprecision(16) << v.r << " " << codes[id] << "\n";
+                break;
+            default:
+                if(s.bits == 1)
+                    os << v.s << codes[id] << "\n";
+                else
+                    os << "b" << v.s << " " << codes[id] << "\n";
+                break;
+            }
+        },
+        from, to);
+    os.flush();
+    return res;
+}
+} // namespace util
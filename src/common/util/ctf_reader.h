@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_CTF_READER_H_
+#define _UTIL_CTF_READER_H_
+
+#include "ctf_format.h"
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace util {
+/**
+ * @brief reader of columnar trace format (CTF) files
+ *
+ * Only the index is read when opening a file. Value changes are decompressed on demand for the requested signals and
+ * the chunks overlapping the requested time slice.
+ */
+class ctf_reader {
+public:
+    //! \brief the description of a signal
+    struct signal {
+        std::string name;
+        ctf::kind type;
+        unsigned bits;
+        //! the id of the signal this one is an alias of, -1 if it is not an alias
+        int alias_of;
+    };
+    //! \brief the callback getting a time stamp, the signal id and its value
+    using callback = std::function<void(uint64_t, unsigned, ctf::value const&)>;
+    /**
+     * @brief opens the file and reads the index
+     *
+     * @param name the file name
+     */
+    explicit ctf_reader(std::string const& name);
+
+    bool is_open() const { return valid; }
+    //! \brief returns the signal table
+    std::vector<signal> const& get_signals() const { return signals; }
+    //! \brief returns the id of the signal with the given hierarchical name or -1 if there is none
+    int find_signal(std::string const& name) const;
+    //! \brief returns the last time stamp found in the file
+    uint64_t get_end_time() const { return end_time; }
+    /**
+     * @brief reads the value changes of the given signals within a time slice in time order
+     *
+     * For each signal having a value at the begin of the slice this value is reported first with time stamp from.
+     * Afterwards all changes within (from, to] are reported.
+     * @param ids the signals to read, aliases report the values of the signal they refer to
+     * @param cb the functor called for each value
+     * @param from the start of the time slice
+     * @param to the end of the time slice
+     * @return false if the file is corrupt
+     */
+    bool read(std::vector<unsigned> const& ids, callback cb, uint64_t from = 0,
+              uint64_t to = std::numeric_limits<uint64_t>::max());
+
+private:
+    struct block {
+        unsigned signal;
+        uint64_t chunk, first_time, last_time, offset;
+        uint32_t comp_size, raw_size, count;
+    };
+    struct change {
+        uint64_t time;
+        unsigned id;
+        ctf::value val;
+    };
+    bool decode(block const& b, unsigned id, std::vector<change>& res);
+
+    std::ifstream in;
+    bool valid{false};
+    uint64_t end_time{0};
+    std::vector<signal> signals;
+    std::vector<block> blocks;
+    std::vector<std::vector<size_t>> signal_blocks;
+    std::string comp_buf, raw_buf;
+};
+/**
+ * @brief converts a CTF file or a part of it into a VCD file
+ *
+ * @param reader the opened CTF file
+ * @param os the stream receiving the VCD content
+ * @param names the hierarchical names of the signals to convert, all if empty
+ * @param from the start of the time slice
+ * @param to the end of the time slice
+ * @return false if the file is corrupt
+ */
+bool ctf_to_vcd(ctf_reader& reader, std::ostream& os, std::vector<std::string> const& names = {}, uint64_t from = 0,
+                uint64_t to = std::numeric_limits<uint64_t>::max());
+} // namespace util
+#endif /* _UTIL_CTF_READER_H_ */
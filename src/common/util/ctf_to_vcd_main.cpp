@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+/*
+ * converts a columnar trace format (CTF) file or a time slice of it into a VCD file:
+ *
+ *     ctf_to_vcd [-f <from>] [-t <to>] <input>.ctf <output>.vcd [<signal> ...]
+ *
+ * from and to are given in the time unit of the CTF file, if no signal is given all signals are converted.
+ */
+#include "ctf_reader.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+int usage(char const* prog) {
+    std::cerr << "usage: " << prog << " [-f <from>] [-t <to>] <input> <output> [<signal> ...]\n";
+    return 2;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint64_t from = 0, to = std::numeric_limits<uint64_t>::max();
+    int i = 1;
+    for(; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        if(!std::strcmp(argv[i], "-f"))
+            from = std::strtoull(argv[i + 1], nullptr, 10);
+        else if(!std::strcmp(argv[i], "-t"))
+            to = std::strtoull(argv[i + 1], nullptr, 10);
+        else
+            return usage(argv[0]);
+    }
+    if(argc - i < 2 || from > to)
+        return usage(argv[0]);
+    util::ctf_reader reader(argv[i]);
+    if(!reader.is_open()) {
+        std::cerr << "could not open " << argv[i] << " as CTF file\n";
+        return 1;
+    }
+    std::ofstream os(argv[i + 1]);
+    if(!os) {
+        std::cerr << "could not create " << argv[i + 1] << "\n";
+        return 1;
+    }
+    std::vector<std::string> names(argv + i + 2, argv + argc);
+    if(!util::ctf_to_vcd(reader, os, names, from, to)) {
+        std::cerr << "could not convert " << argv[i] << ", the file is corrupt or a signal is unknown\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#include "ctf_writer.h"
+#include <algorithm>
+#include <lz4.h>
+#include <memory>
+#include <stdexcept>
+
+namespace util {
+namespace {
+// the minimum amount of raw data compressed by a single task
+constexpr size_t min_task_size = 64 * 1024;
+
+std::string compress_block(std::string const& src) {
+    std::string dst(LZ4_compressBound(src.size()), '\0');
+    auto sz = LZ4_compress_default(src.data(), &dst[0], src.size(), dst.size());
+    if(sz <= 0)
+        throw std::runtime_error("Failed to compress CTF block");
+    dst.resize(sz);
+    return dst;
+}
+} // namespace
+
+ctf_writer::ctf_writer(std::string const& name, size_t chunk_size, unsigned threads)
+: out(name, std::ios::binary | std::ios::trunc)
+, chunk_size(chunk_size) {
+    if(!threads)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    max_pending = 2 * threads;
+    pool.start(threads);
+    if(out.is_open()) {
+        out.write(ctf::magic, sizeof(ctf::magic));
+        offset = sizeof(ctf::magic);
+    }
+}
+
+ctf_writer::~ctf_writer() { close(); }
+
+unsigned ctf_writer::add_signal(std::string const& name, ctf::kind type, unsigned width, int alias_of) {
+    ctf::put_string(signal_table, name);
+    signal_table.push_back(static_cast<char>(type));
+    ctf::put_varint(signal_table, width);
+    ctf::put_varint(signal_table, alias_of < 0 ? 0 : alias_of + 1);
+    bits.push_back(width);
+    columns.emplace_back();
+    return bits.size() - 1;
+}
+
+void ctf_writer::set_time(uint64_t time) {
+    if(time != cur_time && chunk_bytes >= chunk_size)
+        finish_chunk();
+    cur_time = time;
+}
+
+void ctf_writer::emit(unsigned id, uint64_t val) {
+    auto& c = start_change(id);
+    auto sz = c.data.size();
+    ctf::put_varint(c.data, val);
+    chunk_bytes += c.data.size() - sz + 1;
+}
+
+void ctf_writer::emit(unsigned id, double val) {
+    auto& c = start_change(id);
+    char buf[sizeof(double)];
+    memcpy(buf, &val, sizeof(double));
+    c.data.append(buf, sizeof(double));
+    chunk_bytes += sizeof(double) + 1;
+}
+
+void ctf_writer::emit(unsigned id, char const* val) {
+    auto& c = start_change(id);
+    c.data.append(val, bits[id]);
+    chunk_bytes += bits[id] + 1;
+}
+
+void ctf_writer::finish_chunk() {
+    pending.emplace_back();
+    auto& chunk = pending.back();
+    std::vector<std::string> batch;
+    size_t batch_size = 0;
+    auto submit = [this, &chunk, &batch, &batch_size]() {
+        auto blocks = std::make_shared<std::vector<std::string>>(std::move(batch));
+        chunk.results.emplace_back(pool.enqueue([blocks]() {
+            std::vector<std::string> res;
+            res.reserve(blocks->size());
+            for(auto& b : *blocks)
+                res.emplace_back(compress_block(b));
+            return res;
+        }));
+        batch.clear();
+        batch_size = 0;
+    };
+    for(unsigned id = 0; id < columns.size(); ++id) {
+        auto& c = columns[id];
+        if(!c.count)
+            continue;
+        chunk.entries.emplace_back(id, chunk_idx, c.first_time, c.last_time, static_cast<uint32_t>(c.data.size()), c.count);
+        batch_size += c.data.size();
+        batch.emplace_back(std::move(c.data));
+        c = column();
+        if(batch_size >= min_task_size)
+            submit();
+    }
+    if(batch.size())
+        submit();
+    chunk_bytes = 0;
+    ++chunk_idx;
+    write_pending(false);
+}
+
+void ctf_writer::write_pending(bool wait_all) {
+    // write finished chunks in order and block the caller only if too many chunks are in flight
+    while(pending.size()) {
+        auto& chunk = pending.front();
+        if(!wait_all && pending.size() <= max_pending &&
+           std::any_of(std::begin(chunk.results), std::end(chunk.results),
+                       [](std::future<std::vector<std::string>>& f) { return f.wait_for(std::chrono::seconds(0)) != std::future_status::ready; }))
+            return;
+        auto entry = std::begin(chunk.entries);
+        for(auto& f : chunk.results) {
+            for(auto& b : f.get()) {
+                entry->offset = offset;
+                entry->comp_size = b.size();
+                out.write(b.data(), b.size());
+                offset += b.size();
+                index.push_back(*entry++);
+            }
+        }
+        pending.pop_front();
+    }
+}
+
+void ctf_writer::close() {
+    if(!out.is_open())
+        return;
+    finish_chunk();
+    write_pending(true);
+    pool.finish();
+    std::string footer;
+    ctf::put_varint(footer, bits.size());
+    footer.append(signal_table);
+    ctf::put_varint(footer, index.size());
+    for(auto& e : index) {
+        ctf::put_varint(footer, e.signal);
+        ctf::put_varint(footer, e.chunk);
+        ctf::put_varint(footer, e.first_time);
+        ctf::put_varint(footer, e.last_time);
+        ctf::put_varint(footer, e.offset);
+        ctf::put_varint(footer, e.comp_size);
+        ctf::put_varint(footer, e.raw_size);
+        ctf::put_varint(footer, e.count);
+    }
+    out.write(footer.data(), footer.size());
+    char buf[8];
+    for(auto i = 0U; i < 8; ++i)
+        buf[i] = static_cast<char>(offset >> (8 * i));
+    out.write(buf, 8);
+    out.write(ctf::magic, sizeof(ctf::magic));
+    out.close();
+}
+} // namespace util
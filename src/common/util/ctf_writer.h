@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+
+#ifndef _UTIL_CTF_WRITER_H_
+#define _UTIL_CTF_WRITER_H_
+
+#include "ctf_format.h"
+#include "thread_pool.h"
+#include <deque>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace util {
+/**
+ * @brief writer of columnar trace format (CTF) files
+ *
+ * Value changes are collected per signal. Once the collected data exceeds the chunk size a new chunk is started at the
+ * next time change and the column blocks of the finished chunk are compressed by a thread pool while the caller
+ * continues. Compressed blocks are written in order of their chunks, the index is appended when closing the file.
+ */
+class ctf_writer {
+public:
+    /**
+     * @brief opens the file
+     *
+     * @param name the file name
+     * @param chunk_size the amount of raw data collected before a new chunk is started
+     * @param threads the number of threads used for compression, 0 means one per hardware thread
+     */
+    ctf_writer(std::string const& name, size_t chunk_size = 1 << 20, unsigned threads = 0);
+
+    ctf_writer(ctf_writer const&) = delete;
+
+    ctf_writer& operator=(ctf_writer const&) = delete;
+
+    ~ctf_writer();
+
+    bool is_open() const { return out.is_open(); }
+    /**
+     * @brief declares a signal, needs to be called before the first time stamp is set
+     *
+     * @param name the hierarchical name of the signal
+     * @param type the value encoding
+     * @param bits the width of the signal
+     * @param alias_of the id of a signal this one is an alias of, -1 if it is none
+     * @return the id of the signal
+     */
+    unsigned add_signal(std::string const& name, ctf::kind type, unsigned bits, int alias_of = -1);
+    /**
+     * @brief sets the time stamp for the following emit calls, needs to be monotonically increasing
+     *
+     * @param time the time stamp in the time unit of the file (1ps)
+     */
+    void set_time(uint64_t time);
+    //! \brief records a value change of an UINT signal
+    void emit(unsigned id, uint64_t val);
+    //! \brief records a value change of a REAL signal
+    void emit(unsigned id, double val);
+    //! \brief records a value change of a LOGIC signal, val needs to hold one character per bit
+    void emit(unsigned id, char const* val);
+    //! \brief finishes all pending chunks, writes the index and closes the file
+    void close();
+
+private:
+    struct column {
+        std::string data;
+        uint64_t first_time{0}, last_time{0};
+        uint32_t count{0};
+    };
+    struct block_entry {
+        block_entry(unsigned signal, uint64_t chunk, uint64_t first_time, uint64_t last_time, uint32_t raw_size, uint32_t count)
+        : signal(signal)
+        , chunk(chunk)
+        , first_time(first_time)
+        , last_time(last_time)
+        , raw_size(raw_size)
+        , count(count) {}
+        unsigned signal;
+        uint64_t chunk, first_time, last_time, offset{0};
+        uint32_t raw_size, comp_size{0}, count;
+    };
+    struct pending_chunk {
+        std::vector<block_entry> entries;
+        std::vector<std::future<std::vector<std::string>>> results;
+    };
+    inline column& start_change(unsigned id) {
+        auto& c = columns[id];
+        if(!c.count)
+            c.first_time = c.last_time = cur_time;
+        ctf::put_varint(c.data, cur_time - c.last_time);
+        c.last_time = cur_time;
+        ++c.count;
+        return c;
+    }
+    void finish_chunk();
+    void write_pending(bool wait_all);
+
+    std::ofstream out;
+    size_t const chunk_size;
+    size_t chunk_bytes{0};
+    uint64_t chunk_idx{0};
+    uint64_t cur_time{0};
+    uint64_t offset{0};
+    unsigned max_pending;
+    std::string signal_table;
+    std::vector<unsigned> bits;
+    std::vector<column> columns;
+    std::vector<block_entry> index;
+    std::deque<pending_chunk> pending;
+    thread_pool pool;
+};
+} // namespace util
+#endif /* _UTIL_CTF_WRITER_H_ */
@@ -212,13 +212,13 @@ private:
         return (static_cast<C const*>(object_ptr)->*method_ptr)(::std::forward<A>(args)...);
     }
 
-    template <typename> class is_member_pair : std::false_type {};
+    template <typename> struct is_member_pair : std::false_type {};
 
-    template <class C> class is_member_pair<::std::pair<C* const, R (C::*const)(A...)>> : std::true_type {};
+    template <class C> struct is_member_pair<::std::pair<C* const, R (C::*const)(A...)>> : std::true_type {};
 
-    template <typename> class is_const_member_pair : std::false_type {};
+    template <typename> struct is_const_member_pair : std::false_type {};
 
-    template <class C> class is_const_member_pair<::std::pair<C const* const, R (C::*const)(A...) const>> : std::true_type {};
+    template <class C> struct is_const_member_pair<::std::pair<C const* const, R (C::*const)(A...) const>> : std::true_type {};
 
     template <typename T>
     static typename ::std::enable_if<!(is_member_pair<T>{} || is_const_member_pair<T>{}), R>::type functor_stub(void* const object_ptr,
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_HDR_HISTOGRAM_H_
+#define _UTIL_HDR_HISTOGRAM_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a high dynamic range histogram with fixed memory footprint
+ *
+ * Values are sorted into log-linear buckets: values below 2^SUB_BITS are counted exactly, larger values are counted
+ * with a relative precision of 2^-(SUB_BITS-1). The whole uint64_t range is covered, recording is O(1) and does not
+ * allocate.
+ *
+ * @tparam SUB_BITS the number of significant bits kept per value
+ */
+template <unsigned SUB_BITS = 6> class hdr_histogram {
+    static_assert(SUB_BITS >= 2 && SUB_BITS < 32, "SUB_BITS out of range");
+    static constexpr uint64_t half = 1ULL << (SUB_BITS - 1);
+    static constexpr size_t num_buckets = (64 - SUB_BITS) * half + 2 * half;
+
+public:
+    //! \brief records a value
+    inline void record(uint64_t value) { record(value, 1); }
+    //! \brief records a value count times
+    inline void record(uint64_t value, uint64_t count) {
+        buckets[index_of(value)] += count;
+        total += count;
+        sum += static_cast<double>(value) * count;
+        min_val = std::min(min_val, value);
+        max_val = std::max(max_val, value);
+    }
+    //! \brief resets all counters
+    void reset() {
+        buckets.fill(0);
+        total = 0;
+        sum = 0.;
+        min_val = std::numeric_limits<uint64_t>::max();
+        max_val = 0;
+    }
+    //! \brief adds the counts of another histogram
+    void merge(hdr_histogram const& o) {
+        for(size_t i = 0; i < num_buckets; ++i)
+            buckets[i] += o.buckets[i];
+        total += o.total;
+        sum += o.sum;
+        min_val = std::min(min_val, o.min_val);
+        max_val = std::max(max_val, o.max_val);
+    }
+    //! \brief the number of recorded values
+    uint64_t count() const { return total; }
+    //! \brief the smallest recorded value, 0 if empty
+    uint64_t min() const { return total ? min_val : 0; }
+    //! \brief the largest recorded value
+    uint64_t max() const { return max_val; }
+    //! \brief the mean of all recorded values
+    double mean() const { return total ? sum / total : 0.; }
+    /**
+     * @brief returns the value below or at which the given percentage of values fall
+     *
+     * The result is the upper bound of the respective bucket limited to the largest recorded value.
+     * @param percentile the percentile in the range [0, 100]
+     */
+    uint64_t value_at_percentile(double percentile) const {
+        if(!total)
+            return 0;
+        auto target = static_cast<uint64_t>(std::ceil(std::min(100., std::max(0., percentile)) / 100. * total));
+        target = std::max<uint64_t>(target, 1);
+        uint64_t cumulated = 0;
+        for(size_t i = 0; i < num_buckets; ++i) {
+            cumulated += buckets[i];
+            if(cumulated >= target)
+                return std::min(highest_equivalent(i), max_val);
+        }
+        return max_val;
+    }
+    //! \brief calls func(lower bound, upper bound, count) for each non-empty bucket in ascending order
+    template <typename FUNC> void for_each_bucket(FUNC func) const {
+        for(size_t i = 0; i < num_buckets; ++i)
+            if(buckets[i])
+                func(lowest_equivalent(i), highest_equivalent(i), buckets[i]);
+    }
+
+private:
+    static inline size_t index_of(uint64_t value) {
+        if(value < 2 * half)
+            return static_cast<size_t>(value);
+        unsigned msb = 63;
+        while(!(value >> msb))
+            --msb;
+        auto shift = msb - SUB_BITS + 1;
+        return static_cast<size_t>(shift * half + (value >> shift));
+    }
+    static inline uint64_t lowest_equivalent(size_t idx) {
+        if(idx < 2 * half)
+            return idx;
+        auto shift = idx / half - 1;
+        return (idx - shift * half) << shift;
+    }
+    static inline uint64_t highest_equivalent(size_t idx) {
+        if(idx < 2 * half)
+            return idx;
+        auto shift = idx / half - 1;
+        return lowest_equivalent(idx) + ((1ULL << shift) - 1);
+    }
+
+    std::array<uint64_t, num_buckets> buckets{};
+    uint64_t total{0};
+    double sum{0.};
+    uint64_t min_val{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_val{0};
+};
+} // namespace util
+/**@}*/
+#endif /* _UTIL_HDR_HISTOGRAM_H_ */
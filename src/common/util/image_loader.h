@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_IMAGE_LOADER_H_
+#define _UTIL_IMAGE_LOADER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief loaders for memory images (raw binaries, ELF and Intel HEX files)
+ *
+ * The loaders write directly into the storage of the target. It is provided by a span function with the signature
+ * std::pair<uint8_t*, uint64_t>(uint64_t addr, uint64_t len) returning a pointer to the storage at addr and the number
+ * of contiguous bytes available there (at most len), e.g. util::sparse_array::write_span(). All loaders return the
+ * number of bytes written and throw std::runtime_error upon malformed input or if the span function does not provide
+ * any storage for an address.
+ */
+namespace image_loader {
+//! \brief calls the span function and checks that it provides storage
+template <typename SPAN> inline std::pair<uint8_t*, uint64_t> checked_span(SPAN& span, uint64_t addr, uint64_t len) {
+    auto s = span(addr, len);
+    if(!s.first || !s.second || s.second > len)
+        throw std::runtime_error("the image exceeds the target storage at address " + std::to_string(addr));
+    return s;
+}
+//! \brief reads len bytes from a stream into the target
+template <typename SPAN> inline uint64_t stream_into(std::istream& is, uint64_t addr, uint64_t len, SPAN span) {
+    uint64_t done = 0;
+    while(done < len && is.peek() != std::istream::traits_type::eof()) {
+        auto s = checked_span(span, addr + done, len - done);
+        is.read(reinterpret_cast<char*>(s.first), static_cast<std::streamsize>(s.second));
+        auto cnt = static_cast<uint64_t>(is.gcount());
+        done += cnt;
+        if(cnt < s.second)
+            break;
+    }
+    return done;
+}
+//! \brief sets len bytes of the target to zero
+template <typename SPAN> inline void zero_fill(uint64_t addr, uint64_t len, SPAN span) {
+    while(len) {
+        auto s = checked_span(span, addr, len);
+        memset(s.first, 0, s.second);
+        addr += s.second;
+        len -= s.second;
+    }
+}
+/**
+ * @brief loads a raw binary
+ *
+ * @param is the stream to read
+ * @param addr the address of the first byte
+ * @param span the function providing the target storage
+ * @return the number of bytes loaded
+ */
+template <typename SPAN> inline uint64_t load_raw(std::istream& is, uint64_t addr, SPAN span) {
+    return stream_into(is, addr, UINT64_MAX - addr, span);
+}
+/**
+ * @brief loads the PT_LOAD segments of an ELF file (32 or 64bit, either endianess) at their physical address, the
+ * part of a segment not backed by the file (.bss) is zeroed
+ *
+ * @param is the stream to read
+ * @param span the function providing the target storage
+ * @return the number of bytes loaded
+ */
+template <typename SPAN> inline uint64_t load_elf(std::istream& is, SPAN span) {
+    uint8_t ehdr[64];
+    is.read(reinterpret_cast<char*>(ehdr), sizeof(ehdr));
+    if(is.gcount() < 52 || memcmp(ehdr, "\177ELF", 4))
+        throw std::runtime_error("not an ELF file");
+    auto const is64 = ehdr[4] == 2;
+    // the header of ELF64 files is 64 bytes long, the one of ELF32 files 52 bytes
+    if(is64 && is.gcount() < 64)
+        throw std::runtime_error("truncated ELF header");
+    auto const big_endian = ehdr[5] == 2;
+    auto get = [big_endian](uint8_t const* p, unsigned n) {
+        uint64_t v = 0;
+        for(unsigned i = 0; i < n; ++i)
+            v |= static_cast<uint64_t>(p[big_endian ? n - 1 - i : i]) << (8 * i);
+        return v;
+    };
+    auto const phoff = is64 ? get(ehdr + 32, 8) : get(ehdr + 28, 4);
+    auto const phentsize = get(ehdr + (is64 ? 54 : 42), 2);
+    auto const phnum = get(ehdr + (is64 ? 56 : 44), 2);
+    if(phentsize < (is64 ? 56U : 32U))
+        throw std::runtime_error("invalid ELF program header size");
+    is.clear();
+    is.seekg(static_cast<std::streamoff>(phoff));
+    std::vector<uint8_t> phdrs(phentsize * phnum);
+    is.read(reinterpret_cast<char*>(phdrs.data()), static_cast<std::streamsize>(phdrs.size()));
+    if(static_cast<size_t>(is.gcount()) != phdrs.size())
+        throw std::runtime_error("truncated ELF program header table");
+    uint64_t loaded = 0;
+    for(uint64_t i = 0; i < phnum; ++i) {
+        auto const* ph = phdrs.data() + i * phentsize;
+        if(get(ph, 4) != 1) // PT_LOAD
+            continue;
+        auto const offset = is64 ? get(ph + 8, 8) : get(ph + 4, 4);
+        auto const paddr = is64 ? get(ph + 24, 8) : get(ph + 12, 4);
+        auto const filesz = is64 ? get(ph + 32, 8) : get(ph + 16, 4);
+        auto const memsz = is64 ? get(ph + 40, 8) : get(ph + 20, 4);
+        is.clear();
+        is.seekg(static_cast<std::streamoff>(offset));
+        if(stream_into(is, paddr, filesz, span) != filesz)
+            throw std::runtime_error("truncated ELF segment");
+        if(memsz > filesz)
+            zero_fill(paddr + filesz, memsz - filesz, span);
+        loaded += memsz;
+    }
+    return loaded;
+}
+/**
+ * @brief loads an Intel HEX file, data records (00) as well as extended segment (02) and extended linear (04) address
+ * records are supported
+ *
+ * @param is the stream to read
+ * @param span the function providing the target storage
+ * @return the number of bytes loaded
+ */
+template <typename SPAN> inline uint64_t load_ihex(std::istream& is, SPAN span) {
+    auto nibble = [](char c) -> unsigned {
+        if(c >= '0' && c <= '9')
+            return c - '0';
+        if(c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        if(c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        throw std::runtime_error("invalid character in Intel HEX record");
+    };
+    uint64_t base = 0, loaded = 0;
+    std::string line;
+    while(std::getline(is, line)) {
+        while(!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        if(line.empty())
+            continue;
+        if(line[0] != ':' || line.size() < 11 || (line.size() & 1) == 0)
+            throw std::runtime_error("malformed Intel HEX record");
+        auto byte = [&line, &nibble](size_t i) { return static_cast<uint8_t>(nibble(line[1 + 2 * i]) << 4 | nibble(line[2 + 2 * i])); };
+        auto const count = byte(0);
+        if(line.size() != 11U + 2 * count)
+            throw std::runtime_error("Intel HEX record length mismatch");
+        uint8_t sum = 0;
+        for(size_t i = 0; i < 5U + count; ++i)
+            sum += byte(i);
+        if(sum)
+            throw std::runtime_error("Intel HEX record checksum error");
+        auto const offset = static_cast<uint64_t>(byte(1)) << 8 | byte(2);
+        switch(byte(3)) {
+        case 0: {
+            for(size_t i = 0; i < count;) {
+                auto s = checked_span(span, base + offset + i, count - i);
+                for(uint64_t j = 0; j < s.second; ++j, ++i)
+                    s.first[j] = byte(4 + i);
+            }
+            loaded += count;
+            break;
+        }
+        case 1:
+            return loaded;
+        case 2:
+            base = (static_cast<uint64_t>(byte(4)) << 8 | byte(5)) << 4;
+            break;
+        case 4:
+            base = (static_cast<uint64_t>(byte(4)) << 8 | byte(5)) << 16;
+            break;
+        default: // start addresses are not relevant for the memory contents
+            break;
+        }
+    }
+    return loaded;
+}
+/**
+ * @brief loads an image file, the format is detected by its contents: ELF files by their magic number, Intel HEX
+ * files by the leading colon, everything else is loaded as raw binary
+ *
+ * @param file_name the name of the file
+ * @param span the function providing the target storage
+ * @param raw_addr the load address of raw binaries
+ * @return the number of bytes loaded
+ */
+template <typename SPAN> inline uint64_t load(std::string const& file_name, SPAN span, uint64_t raw_addr = 0) {
+    std::ifstream is(file_name, std::ios::binary);
+    if(!is)
+        throw std::runtime_error("cannot open image file " + file_name);
+    char magic[4]{};
+    is.read(magic, sizeof(magic));
+    is.clear();
+    is.seekg(0);
+    if(!memcmp(magic, "\177ELF", 4))
+        return load_elf(is, span);
+    if(magic[0] == ':')
+        return load_ihex(is, span);
+    return load_raw(is, raw_addr, span);
+}
+} // namespace image_loader
+} // namespace util
+/**@}*/
+#endif /* _UTIL_IMAGE_LOADER_H_ */
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_INTERNED_NAMES_H_
+#define _UTIL_INTERNED_NAMES_H_
+
+#include "string_interner.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief helpers to build the attribute names of recorded transactions using the shared string interner
+ *
+ * The prefix of the attributes is interned once and the names of the fields are added as children of it instead of
+ * being built per transaction. The generator and extension types are template parameters so that the helpers can be
+ * shared by all transaction recording backends without depending on a particular recording API.
+ */
+namespace interned_names {
+using path_id = string_interner::id_type;
+/**
+ * @brief interns an attribute prefix as path
+ *
+ * @param prefix the prefix, may be nullptr
+ * @return the id of the path or string_interner::npos if the prefix is null or empty
+ */
+inline path_id intern_prefix(char const* prefix) {
+    return prefix && *prefix ? string_interner::get().intern_path(prefix) : string_interner::npos;
+}
+/**
+ * @brief returns the interned begin or end attribute prefix of a generator
+ *
+ * The prefixes are interned upon the first transaction of the generator and are looked up by its id afterwards.
+ *
+ * @param g the generator providing get_id(), get_begin_attribute_name() and get_end_attribute_name()
+ * @param end if true the prefix of the end attributes is returned, the one of the begin attributes otherwise
+ * @return the id of the prefix path
+ */
+template <typename GENERATOR> inline path_id generator_prefix(GENERATOR const& g, bool end) {
+    static std::unordered_map<uint64_t, std::array<path_id, 2>> prefixes;
+    auto it = prefixes.find(g.get_id());
+    if(it == prefixes.end()) {
+        std::array<path_id, 2> ids{{intern_prefix(g.get_begin_attribute_name()), intern_prefix(g.get_end_attribute_name())}};
+        it = prefixes.emplace(g.get_id(), ids).first;
+    }
+    return it->second[end ? 1 : 0];
+}
+/**
+ * @brief returns the full name of an attribute below a prefix
+ *
+ * @param prefix the interned prefix or string_interner::npos
+ * @param exts the extension providing get_name()
+ * @return the name of the attribute, '<unnamed>' if neither a prefix nor a name is given
+ */
+template <typename EXTENSION> inline std::string const& get_name(path_id prefix, EXTENSION const* exts) {
+    static const std::string unnamed{"<unnamed>"};
+    auto name = exts->get_name();
+    if(name != nullptr && *name != 0)
+        return string_interner::get().child_path_str(prefix, name);
+    return prefix == string_interner::npos ? unnamed : string_interner::get().path_str(prefix);
+}
+} // namespace interned_names
+} // namespace util
+/**@}*/
+#endif /* _UTIL_INTERNED_NAMES_H_ */
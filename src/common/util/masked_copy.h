@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_MASKED_COPY_H_
+#define _UTIL_MASKED_COPY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTIL_MASKED_COPY_SSE2
+#endif
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief copies the bits of src selected by mask into dst: dst = (src & mask) | (dst & ~mask)
+ *
+ * Using a bitwise blend the function implements TLM byte enables (0xff enabled, 0x00 disabled) without branches.
+ * Depending on the target instruction set AVX2 or SSE2 is used, otherwise the data is processed in 64bit words.
+ *
+ * @param dst the destination
+ * @param src the source
+ * @param mask the mask, one byte per byte of data
+ * @param len the number of bytes to process
+ */
+inline void masked_copy(uint8_t* dst, uint8_t const* src, uint8_t const* mask, size_t len) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for(; i + 32 <= len; i += 32) {
+        auto m = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(mask + i));
+        auto s = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+        auto d = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(_mm256_and_si256(m, s), _mm256_andnot_si256(m, d)));
+    }
+#elif defined(UTIL_MASKED_COPY_SSE2)
+    for(; i + 16 <= len; i += 16) {
+        auto m = _mm_loadu_si128(reinterpret_cast<__m128i const*>(mask + i));
+        auto s = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+        auto d = _mm_loadu_si128(reinterpret_cast<__m128i const*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, d)));
+    }
+#endif
+    for(; i + 8 <= len; i += 8) {
+        uint64_t m, s, d;
+        memcpy(&m, mask + i, 8);
+        memcpy(&s, src + i, 8);
+        memcpy(&d, dst + i, 8);
+        d = (s & m) | (d & ~m);
+        memcpy(dst + i, &d, 8);
+    }
+    for(; i < len; ++i)
+        dst[i] = (src[i] & mask[i]) | (dst[i] & ~mask[i]);
+}
+/**
+ * @brief copies len bytes from src to dst applying a byte enable pattern which repeats every be_len bytes
+ *
+ * This implements the byte enable semantics of the TLM generic payload: byte i of the data is enabled by
+ * byte_enable[(offset + i) % be_len]. Short patterns are replicated into a local buffer so that the blend operates
+ * on full vectors.
+ *
+ * @param dst the destination
+ * @param src the source
+ * @param be the byte enable array
+ * @param be_len the length of the byte enable array
+ * @param offset the position of src[0] within the data of the payload
+ * @param len the number of bytes to copy
+ */
+inline void masked_copy(uint8_t* dst, uint8_t const* src, uint8_t const* be, size_t be_len, size_t offset, size_t len) {
+    if(!be || !be_len) {
+        memcpy(dst, src, len);
+        return;
+    }
+    offset %= be_len;
+    if(offset + len <= be_len) {
+        masked_copy(dst, src, be + offset, len);
+        return;
+    }
+    constexpr size_t buf_size = 256;
+    if(be_len <= buf_size / 2) {
+        // replicate the pattern, the buffer holds a multiple of be_len plus the pattern rotated by offset
+        uint8_t buf[buf_size + buf_size / 2];
+        auto period = (buf_size / be_len) * be_len;
+        for(size_t i = 0; i < period + be_len; ++i)
+            buf[i] = be[i % be_len];
+        for(size_t i = 0; i < len; i += period)
+            masked_copy(dst + i, src + i, buf + offset, std::min(period, len - i));
+        return;
+    }
+    for(size_t i = 0; i < len;) {
+        auto chunk = std::min(be_len - offset, len - i);
+        masked_copy(dst + i, src + i, be + offset, chunk);
+        i += chunk;
+        offset = 0;
+    }
+}
+} // namespace util
+/**@}*/
+#endif /* _UTIL_MASKED_COPY_H_ */
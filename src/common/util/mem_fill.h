@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_MEM_FILL_H_
+#define _UTIL_MEM_FILL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief the SplitMix64 finalizer, a fast bijective mixing function
+ *
+ * Applied to a counter it yields a high quality pseudo random sequence which can be evaluated at any position.
+ */
+inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+/**
+ * @brief fills a memory area with data generated per 8 byte word
+ *
+ * The data only depends on the address, not on the size or alignment of the access. Word w covers the addresses
+ * [8*w, 8*w+7] and its value is stored in little endian byte order.
+ *
+ * @param dst the buffer to fill
+ * @param addr the address of the first byte
+ * @param len the number of bytes to fill
+ * @param gen the generator returning the value of a word given its word index
+ */
+template <typename GEN> inline void fill_words(uint8_t* dst, uint64_t addr, size_t len, GEN gen) {
+    auto store = [](uint8_t* d, uint64_t v, unsigned from, unsigned to) {
+        for(auto i = from; i < to; ++i)
+            *d++ = static_cast<uint8_t>(v >> (8 * i));
+    };
+    auto offs = static_cast<unsigned>(addr & 7);
+    auto word = addr >> 3;
+    if(offs) {
+        auto cnt = len < 8U - offs ? static_cast<unsigned>(len) : 8U - offs;
+        store(dst, gen(word++), offs, offs + cnt);
+        dst += cnt;
+        len -= cnt;
+    }
+    for(; len >= 8; len -= 8, dst += 8) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        auto v = gen(word++);
+        memcpy(dst, &v, 8);
+#else
+        store(dst, gen(word++), 0, 8);
+#endif
+    }
+    if(len)
+        store(dst, gen(word), 0, static_cast<unsigned>(len));
+}
+//! \brief derives a seed from a (instance) name, stable across runs and platforms (FNV-1a)
+inline uint64_t seed_from_name(char const* name) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for(; name && *name; ++name)
+        h = (h ^ static_cast<uint8_t>(*name)) * 0x100000001b3ULL;
+    return h;
+}
+//! \brief fills a memory area with an 8 byte pattern aligned to the address
+inline void fill_pattern(uint8_t* dst, uint64_t addr, size_t len, uint64_t pattern) {
+    fill_words(dst, addr, len, [pattern](uint64_t) { return pattern; });
+}
+//! \brief fills a memory area with a hash of the word address, identical for all memories
+inline void fill_addr_hash(uint8_t* dst, uint64_t addr, size_t len) {
+    fill_words(dst, addr, len, [](uint64_t w) { return (w << 3) * 0x9e3779b97f4a7c15ULL ^ (w << 3); });
+}
+//! \brief fills a memory area with counter based pseudo random data (SplitMix64 of the seeded word address)
+inline void fill_random(uint8_t* dst, uint64_t addr, size_t len, uint64_t seed) {
+    auto key = splitmix64(seed);
+    fill_words(dst, addr, len, [key](uint64_t w) { return splitmix64(w ^ key); });
+}
+} // namespace util
+/**@}*/
+#endif /* _UTIL_MEM_FILL_H_ */
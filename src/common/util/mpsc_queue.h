@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_MPSC_QUEUE_H_
+#define _UTIL_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief an unbounded lock-free multi-producer single-consumer queue (D. Vyukov)
+ *
+ * Pushing is wait-free and can be done from any thread, popping must only be done by a single consumer thread.
+ *
+ * @tparam T the element type, it needs to be default and move constructible
+ */
+template <typename T> class mpsc_queue {
+    struct node {
+        std::atomic<node*> next{nullptr};
+        T value;
+        node() = default;
+        explicit node(T&& v)
+        : value(std::move(v)) {}
+    };
+
+public:
+    mpsc_queue()
+    : head(new node)
+    , tail(head.load(std::memory_order_relaxed)) {}
+
+    mpsc_queue(mpsc_queue const&) = delete;
+    mpsc_queue& operator=(mpsc_queue const&) = delete;
+
+    ~mpsc_queue() {
+        T v;
+        while(pop(v))
+            ;
+        delete tail;
+    }
+    /**
+     * @brief adds an element, can be called from any thread
+     *
+     * @param v the element
+     */
+    void push(T v) {
+        auto* n = new node(std::move(v));
+        auto* prev = head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+    /**
+     * @brief removes an element, must only be called from the consumer thread
+     *
+     * An element whose push has not completed yet may not be visible, hence the function might return false although
+     * a push is in progress.
+     *
+     * @param v the removed element
+     * @return false if the queue is empty
+     */
+    bool pop(T& v) {
+        auto* next = tail->next.load(std::memory_order_acquire);
+        if(!next)
+            return false;
+        v = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+    //! \brief returns true if the queue appears empty, must only be called from the consumer thread
+    bool empty() const { return tail->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    std::atomic<node*> head;
+    char pad[64];
+    node* tail;
+};
+} // namespace util
+/**@}*/
+#endif /* _UTIL_MPSC_QUEUE_H_ */
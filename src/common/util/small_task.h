@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_SMALL_TASK_H_
+#define _UTIL_SMALL_TASK_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a move-only type erased callable void() storing callables of up to 64 bytes without heap allocation
+ */
+class small_task {
+public:
+    //! the size of the inline storage
+    static constexpr size_t inline_size = 64;
+
+    small_task() = default;
+
+    template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, small_task>::value>::type>
+    small_task(F&& f) { // NOLINT: implicit conversion is intended
+        using T = typename std::decay<F>::type;
+        emplace<T>(std::forward<F>(f), std::integral_constant<bool, fits_inline<T>()>());
+    }
+
+    small_task(small_task&& o) noexcept { move_from(o); }
+
+    small_task& operator=(small_task&& o) noexcept {
+        if(this != &o) {
+            reset();
+            move_from(o);
+        }
+        return *this;
+    }
+
+    small_task(small_task const&) = delete;
+    small_task& operator=(small_task const&) = delete;
+
+    ~small_task() { reset(); }
+    //! \brief returns true if a callable is stored
+    explicit operator bool() const { return invoke_fn != nullptr; }
+    //! \brief calls the stored callable
+    void operator()() { invoke_fn(&storage); }
+    //! \brief destroys the stored callable
+    void reset() {
+        if(manage_fn)
+            manage_fn(&storage, nullptr);
+        invoke_fn = nullptr;
+        manage_fn = nullptr;
+    }
+
+private:
+    template <typename T> static constexpr bool fits_inline() {
+        return sizeof(T) <= inline_size && alignof(T) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<T>::value;
+    }
+    // manage_fn(dst, src) move-constructs dst from src and destroys src, manage_fn(dst, nullptr) destroys dst
+    template <typename T, typename F> void emplace(F&& f, std::true_type) {
+        new(&storage) T(std::forward<F>(f));
+        invoke_fn = [](void* p) { (*static_cast<T*>(p))(); };
+        manage_fn = [](void* dst, void* src) {
+            if(src) {
+                new(dst) T(std::move(*static_cast<T*>(src)));
+                static_cast<T*>(src)->~T();
+            } else
+                static_cast<T*>(dst)->~T();
+        };
+    }
+
+    template <typename T, typename F> void emplace(F&& f, std::false_type) {
+        new(&storage) T*(new T(std::forward<F>(f)));
+        invoke_fn = [](void* p) { (**static_cast<T**>(p))(); };
+        manage_fn = [](void* dst, void* src) {
+            if(src)
+                *static_cast<T**>(dst) = *static_cast<T**>(src);
+            else
+                delete *static_cast<T**>(dst);
+        };
+    }
+
+    void move_from(small_task& o) noexcept {
+        if(o.manage_fn)
+            o.manage_fn(&storage, &o.storage);
+        invoke_fn = o.invoke_fn;
+        manage_fn = o.manage_fn;
+        o.invoke_fn = nullptr;
+        o.manage_fn = nullptr;
+    }
+
+    typename std::aligned_storage<inline_size, alignof(std::max_align_t)>::type storage;
+    void (*invoke_fn)(void*){nullptr};
+    void (*manage_fn)(void*, void*){nullptr};
+};
+} // namespace util
+/**@}*/
+#endif /* _UTIL_SMALL_TASK_H_ */
@@ -17,8 +17,15 @@
 #ifndef _SPARSE_ARRAY_H_
 #define _SPARSE_ARRAY_H_
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 /**
  * \ingroup scc-common
@@ -32,6 +39,10 @@ namespace util {
  *
  *  a simple array which allocates memory in configurable chunks (size of 2^PAGE_ADDR_BITS), used for
  *  large sparse arrays. Memory is allocated on demand
+ *
+ *  Pages are reference counted and copied on write: a snapshot shares all allocated pages with the array and a page
+ *  is only duplicated once it is modified while being shared. Pages may also be provided lazily by a loader which is
+ *  invoked upon the first access of the page (see util/sparse_array_io.h).
  */
 template <typename T, uint64_t SIZE, unsigned PAGE_ADDR_BITS = 24> class sparse_array {
 public:
@@ -46,41 +57,45 @@ public:
     const uint64_t page_addr_width = PAGE_ADDR_BITS;
 
     using page_type = std::array<T, 1 << PAGE_ADDR_BITS>;
+    //! the contents of a sparse array: the page number and the (shared) page of each allocated page
+    using snapshot_type = std::vector<std::pair<uint64_t, std::shared_ptr<const page_type>>>;
+    //! the type of the function filling a lazily provided page, it returns false if the page could not be loaded
+    using page_loader_type = std::function<bool(uint64_t, page_type&)>;
     /**
      * the default constructor
      */
-    sparse_array() { arr.fill(nullptr); }
-    /**
-     * the destructor
-     */
-    ~sparse_array() {
-        for(auto i : arr)
-            delete i;
-    }
+    sparse_array() = default;
     /**
      * element access operator
      *
      * @param addr address to access
      * @return the data type reference
      */
-    T& operator[](uint32_t addr) {
+    T& operator[](uint64_t addr) {
         assert(addr < SIZE);
-        T nr = addr >> PAGE_ADDR_BITS;
-        if(arr[nr] == nullptr)
-            arr[nr] = new page_type();
-        return arr[nr]->at(addr & page_addr_mask);
+        return page_for_write(addr >> PAGE_ADDR_BITS)[addr & page_addr_mask];
     }
     /**
-     * page fetch operator
+     * page fetch operator, the page is allocated resp. unshared since the caller may modify it
      *
      * @param page_nr the page number ot fetch
      * @return reference to page
      */
-    page_type& operator()(uint32_t page_nr) {
+    page_type& operator()(uint64_t page_nr) {
         assert(page_nr < page_count);
-        if(arr[page_nr] == nullptr)
-            arr.at(page_nr) = new page_type();
-        return *(arr[page_nr]);
+        return page_for_write(page_nr);
+    }
+    /**
+     * read-only page access which does not allocate or unshare the page
+     *
+     * @param page_nr the page number ot fetch
+     * @return pointer to the page or nullptr if the page is not allocated
+     */
+    page_type const* get_page(uint64_t page_nr) {
+        assert(page_nr < page_count);
+        if(!arr[page_nr] && is_pending(page_nr))
+            load_page(page_nr);
+        return arr[page_nr].get();
     }
     /**
      * check if page for address is allocated
@@ -88,10 +103,10 @@ public:
      * @param addr the address to check
      * @return true if the page is allocated
      */
-    bool is_allocated(uint32_t addr) {
+    bool is_allocated(uint64_t addr) {
         assert(addr < SIZE);
-        T nr = addr >> PAGE_ADDR_BITS;
-        return arr.at(nr) != nullptr;
+        uint64_t nr = addr >> PAGE_ADDR_BITS;
+        return arr.at(nr) != nullptr || is_pending(nr);
     }
     /**
      * get the size of the array
@@ -99,9 +114,189 @@ public:
      * @return the size
      */
     uint64_t size() { return SIZE; }
+    /**
+     * calls f(addr, page, page offset, length) for each run of a range within a single page, page is nullptr for pages
+     * not being allocated
+     *
+     * @param addr the start address
+     * @param len the length of the range
+     * @param f the function to call
+     */
+    template <typename FUNC> void for_each_page_run(uint64_t addr, uint64_t len, FUNC f) {
+        assert(addr + len <= SIZE);
+        while(len) {
+            auto offs = addr & page_addr_mask;
+            auto run = std::min<uint64_t>(page_size - offs, len);
+            f(addr, get_page(addr >> PAGE_ADDR_BITS), offs, run);
+            addr += run;
+            len -= run;
+        }
+    }
+    /**
+     * returns the writable storage at addr, the page is allocated resp. unshared
+     *
+     * @param addr the address
+     * @param len the requested length
+     * @return the pointer to the element at addr and the number of contiguous elements, at most len
+     */
+    std::pair<T*, uint64_t> write_span(uint64_t addr, uint64_t len) {
+        assert(addr < SIZE);
+        auto offs = addr & page_addr_mask;
+        return {page_for_write(addr >> PAGE_ADDR_BITS).data() + offs, std::min<uint64_t>(page_size - offs, len)};
+    }
+    /**
+     * copies a range of elements, unallocated pages read as value initialized elements
+     *
+     * @param addr the start address
+     * @param dst the destination
+     * @param len the number of elements
+     */
+    void read(uint64_t addr, T* dst, uint64_t len) {
+        for_each_page_run(addr, len, [&dst](uint64_t, page_type const* p, uint64_t offs, uint64_t run) {
+            if(p)
+                std::copy(p->data() + offs, p->data() + offs + run, dst);
+            else
+                std::fill(dst, dst + run, T{});
+            dst += run;
+        });
+    }
+    /**
+     * writes a range of elements
+     *
+     * @param addr the start address
+     * @param src the source
+     * @param len the number of elements
+     */
+    void write(uint64_t addr, T const* src, uint64_t len) {
+        assert(addr + len <= SIZE);
+        while(len) {
+            auto s = write_span(addr, len);
+            std::copy(src, src + s.second, s.first);
+            src += s.second;
+            addr += s.second;
+            len -= s.second;
+        }
+    }
+    /**
+     * sets a range of elements to a value
+     *
+     * @param addr the start address
+     * @param val the value
+     * @param len the number of elements
+     */
+    void fill(uint64_t addr, T const& val, uint64_t len) {
+        assert(addr + len <= SIZE);
+        while(len) {
+            auto s = write_span(addr, len);
+            std::fill(s.first, s.first + s.second, val);
+            addr += s.second;
+            len -= s.second;
+        }
+    }
+    /**
+     * compares a range of elements with a buffer, unallocated pages compare as value initialized elements
+     *
+     * @param addr the start address
+     * @param src the data to compare with
+     * @param len the number of elements
+     * @return true if all elements are equal
+     */
+    bool compare(uint64_t addr, T const* src, uint64_t len) {
+        bool equal = true;
+        for_each_page_run(addr, len, [&src, &equal](uint64_t, page_type const* p, uint64_t offs, uint64_t run) {
+            if(equal)
+                equal = p ? std::equal(src, src + run, p->data() + offs)
+                          : std::all_of(src, src + run, [](T const& e) { return e == T{}; });
+            src += run;
+        });
+        return equal;
+    }
+    /**
+     * frees all pages
+     */
+    void clear() {
+        for(auto& p : arr)
+            p.reset();
+        pending.clear();
+        loader = nullptr;
+    }
+    /**
+     * creates a snapshot of the allocated pages. The pages are shared until either the array or the snapshot is
+     * modified, hence taking a snapshot does not copy any data. Lazily provided pages are loaded beforehand.
+     *
+     * @return the snapshot
+     */
+    snapshot_type snapshot() {
+        snapshot_type ret;
+        for(uint64_t nr = 0; nr < page_count; ++nr)
+            if(get_page(nr))
+                ret.emplace_back(nr, arr[nr]);
+        return ret;
+    }
+    /**
+     * replaces the contents of the array by the snapshot, the pages are shared with the snapshot
+     *
+     * @param snapshot the snapshot to restore
+     * @throws std::runtime_error if the snapshot contains a page outside of the array, the array is left unchanged
+     */
+    void restore(snapshot_type const& snapshot) {
+        for(auto& e : snapshot)
+            check_page_nr(e.first);
+        clear();
+        for(auto& e : snapshot)
+            arr[e.first] = std::const_pointer_cast<page_type>(e.second);
+    }
+    /**
+     * replaces the contents of the array by pages which are provided by the loader upon their first access
+     *
+     * A page whose loader fails stays pending and the access to it throws a std::runtime_error.
+     *
+     * @param page_nrs the numbers of the pages being provided
+     * @param page_loader the function filling a page
+     * @throws std::runtime_error if a page number is outside of the array, the array is left unchanged
+     */
+    void set_lazy_pages(std::vector<uint64_t> const& page_nrs, page_loader_type page_loader) {
+        for(auto nr : page_nrs)
+            check_page_nr(nr);
+        clear();
+        pending.resize(arr.size(), false);
+        for(auto nr : page_nrs)
+            pending[nr] = true;
+        loader = std::move(page_loader);
+    }
 
 protected:
-    std::array<page_type*, SIZE / (1 << PAGE_ADDR_BITS) + 1> arr;
+    void check_page_nr(uint64_t nr) const {
+        if(nr >= page_count)
+            throw std::runtime_error("page number " + std::to_string(nr) + " is outside of the sparse array of " +
+                                     std::to_string(page_count) + " pages");
+    }
+
+    bool is_pending(uint64_t nr) const { return nr < pending.size() && pending[nr]; }
+
+    void load_page(uint64_t nr) {
+        auto p = std::make_shared<page_type>();
+        if(!loader(nr, *p))
+            throw std::runtime_error("page " + std::to_string(nr) + " of the sparse array could not be loaded");
+        pending[nr] = false;
+        arr[nr] = std::move(p);
+    }
+
+    page_type& page_for_write(uint64_t nr) {
+        auto& p = arr[nr];
+        if(!p) {
+            if(is_pending(nr))
+                load_page(nr);
+            if(!p)
+                p = std::make_shared<page_type>();
+        } else if(p.use_count() > 1)
+            p = std::make_shared<page_type>(*p);
+        return *p;
+    }
+
+    std::array<std::shared_ptr<page_type>, SIZE / (1 << PAGE_ADDR_BITS) + 1> arr;
+    std::vector<bool> pending;
+    page_loader_type loader;
 };
 } // namespace util
 /** @}*/
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_SPARSE_ARRAY_IO_H_
+#define _UTIL_SPARSE_ARRAY_IO_H_
+
+#include "lz4_streambuf.h"
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace util {
+/**
+ * @brief writes the allocated pages of a sparse array as LZ4 compressed snapshot
+ *
+ * Each page is stored as an independent LZ4 frame followed by an index of the page offsets so that pages can be
+ * restored individually. Layout: header (magic, page bytes), frames, index (count, {page nr, offset}...), trailer
+ * (index offset, magic).
+ *
+ * @param arr the sparse array
+ * @param file_name the name of the snapshot file
+ */
+template <typename SPARSE_ARRAY> void save_snapshot(SPARSE_ARRAY& arr, std::string const& file_name) {
+    static const char magic[8] = {'S', 'C', 'C', 'S', 'N', 'A', 'P', '1'};
+    using page_type = typename SPARSE_ARRAY::page_type;
+    std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+    if(!os)
+        throw std::runtime_error("Cannot open snapshot file " + file_name);
+    auto write_u64 = [&os](uint64_t v) { os.write(reinterpret_cast<char const*>(&v), sizeof(v)); };
+    os.write(magic, sizeof(magic));
+    write_u64(sizeof(page_type));
+    std::vector<std::pair<uint64_t, uint64_t>> index;
+    for(auto& e : arr.snapshot()) {
+        index.emplace_back(e.first, static_cast<uint64_t>(os.tellp()));
+        lz4c_steambuf buf(os, 64 * 1024);
+        std::ostream cs(&buf);
+        cs.write(reinterpret_cast<char const*>(e.second->data()), sizeof(page_type));
+        buf.close();
+    }
+    auto index_pos = static_cast<uint64_t>(os.tellp());
+    write_u64(index.size());
+    for(auto& e : index) {
+        write_u64(e.first);
+        write_u64(e.second);
+    }
+    write_u64(index_pos);
+    os.write(magic, sizeof(magic));
+    if(!os)
+        throw std::runtime_error("Failed to write snapshot file " + file_name);
+}
+/**
+ * @brief restores a sparse array from a snapshot written by save_snapshot()
+ *
+ * Only the index is read, the pages are decompressed upon their first access. The file stays open as long as pages
+ * are pending.
+ *
+ * @param arr the sparse array
+ * @param file_name the name of the snapshot file
+ * @throws std::runtime_error if the file cannot be read, does not match the array or its index is corrupt. The array
+ * is left unchanged in this case.
+ */
+template <typename SPARSE_ARRAY> void load_snapshot(SPARSE_ARRAY& arr, std::string const& file_name) {
+    static const char magic[8] = {'S', 'C', 'C', 'S', 'N', 'A', 'P', '1'};
+    using page_type = typename SPARSE_ARRAY::page_type;
+    auto is = std::make_shared<std::ifstream>(file_name, std::ios::binary);
+    if(!*is)
+        throw std::runtime_error("Cannot open snapshot file " + file_name);
+    auto read_u64 = [is]() {
+        uint64_t v{0};
+        is->read(reinterpret_cast<char*>(&v), sizeof(v));
+        return v;
+    };
+    char hdr[8];
+    is->read(hdr, sizeof(hdr));
+    if(!*is || memcmp(hdr, magic, sizeof(magic)) || read_u64() != sizeof(page_type))
+        throw std::runtime_error("Snapshot file " + file_name + " does not match the array");
+    is->seekg(-static_cast<std::streamoff>(sizeof(uint64_t) + sizeof(magic)), std::ios::end);
+    auto index_pos = read_u64();
+    is->read(hdr, sizeof(hdr));
+    if(!*is || memcmp(hdr, magic, sizeof(magic)))
+        throw std::runtime_error("Snapshot file " + file_name + " is truncated");
+    is->seekg(static_cast<std::streamoff>(index_pos));
+    auto count = read_u64();
+    std::vector<uint64_t> page_nrs;
+    auto offsets = std::make_shared<std::unordered_map<uint64_t, uint64_t>>();
+    for(uint64_t i = 0; i < count && *is; ++i) {
+        auto nr = read_u64();
+        auto offset = read_u64();
+        if(*is && (nr >= arr.page_count || offset >= index_pos))
+            throw std::runtime_error("Snapshot file " + file_name + " contains page " + std::to_string(nr) + " at offset " +
+                                     std::to_string(offset) + " outside of the array or the file");
+        page_nrs.push_back(nr);
+        (*offsets)[nr] = offset;
+    }
+    if(!*is)
+        throw std::runtime_error("Snapshot file " + file_name + " has a corrupt index");
+    arr.set_lazy_pages(page_nrs, [is, offsets](uint64_t nr, page_type& page) -> bool {
+        auto it = offsets->find(nr);
+        if(it == offsets->end())
+            return false;
+        is->clear();
+        is->seekg(static_cast<std::streamoff>(it->second));
+        lz4d_streambuf buf(*is, 64 * 1024);
+        std::istream ds(&buf);
+        ds.read(reinterpret_cast<char*>(page.data()), sizeof(page_type));
+        return ds.gcount() == sizeof(page_type);
+    });
+}
+} // namespace util
+#endif /* _UTIL_SPARSE_ARRAY_IO_H_ */
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include <util/string_interner.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace util;
+
+constexpr string_interner::id_type string_interner::npos;
+
+string_interner& string_interner::get() {
+    static string_interner instance;
+    return instance;
+}
+
+string_interner::id_type string_interner::intern_locked(char const* s, size_t len) {
+    auto it = symbol_ids.find(symbol_key{s, len});
+    if(it != symbol_ids.end())
+        return it->second;
+    symbols.emplace_back(s, len);
+    bytes += len + 1;
+    auto id = static_cast<id_type>(symbols.size() - 1);
+    symbol_ids.emplace(symbol_key{symbols.back().data(), len}, id);
+    return id;
+}
+
+string_interner::id_type string_interner::find_locked(char const* s, size_t len) const {
+    auto it = symbol_ids.find(symbol_key{s, len});
+    return it == symbol_ids.end() ? npos : it->second;
+}
+
+string_interner::id_type string_interner::intern(char const* s, size_t len) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return intern_locked(s, len);
+}
+
+string_interner::id_type string_interner::find(char const* s, size_t len) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return find_locked(s, len);
+}
+
+std::string const& string_interner::str(id_type id) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return symbols.at(id);
+}
+
+string_interner::id_type string_interner::intern_path_locked(id_type parent, id_type leaf) {
+    auto key = path_key(parent, leaf);
+    auto it = path_ids.find(key);
+    if(it != path_ids.end())
+        return it->second;
+    paths.push_back(path_node{parent, leaf, nullptr});
+    auto id = static_cast<id_type>(paths.size() - 1);
+    path_ids.emplace(key, id);
+    return id;
+}
+
+string_interner::id_type string_interner::intern_path(char const* name, size_t len) {
+    std::lock_guard<std::mutex> lock(mtx);
+    id_type path = npos;
+    auto end = name + len;
+    while(true) {
+        auto pos = std::find(name, end, sep);
+        path = intern_path_locked(path, intern_locked(name, pos - name));
+        if(pos == end)
+            return path;
+        name = pos + 1;
+    }
+}
+
+string_interner::id_type string_interner::intern_child(id_type parent, char const* leaf, size_t len) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return intern_path_locked(parent, intern_locked(leaf, len));
+}
+
+std::string const& string_interner::child_path_str(id_type parent, char const* leaf, size_t len) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return path_str_locked(intern_path_locked(parent, intern_locked(leaf, len)));
+}
+
+string_interner::id_type string_interner::find_path(char const* name, size_t len) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    id_type path = npos;
+    auto end = name + len;
+    while(true) {
+        auto pos = std::find(name, end, sep);
+        auto sym = find_locked(name, pos - name);
+        if(sym == npos)
+            return npos;
+        auto it = path_ids.find(path_key(path, sym));
+        if(it == path_ids.end())
+            return npos;
+        path = it->second;
+        if(pos == end)
+            return path;
+        name = pos + 1;
+    }
+}
+
+std::vector<string_interner::id_type> string_interner::components(id_type path) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    std::vector<id_type> ret;
+    for(auto p = path; p != npos; p = paths.at(p).parent)
+        ret.push_back(paths[p].leaf);
+    std::reverse(ret.begin(), ret.end());
+    return ret;
+}
+
+string_interner::id_type string_interner::parent(id_type path) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return paths.at(path).parent;
+}
+
+string_interner::id_type string_interner::leaf(id_type path) const {
+    std::lock_guard<std::mutex> lock(mtx);
+    return paths.at(path).leaf;
+}
+
+std::string const& string_interner::path_str(id_type path) {
+    std::lock_guard<std::mutex> lock(mtx);
+    return path_str_locked(path);
+}
+
+std::string const& string_interner::path_str_locked(id_type path) {
+    auto& node = paths.at(path);
+    if(!node.full) {
+        std::vector<id_type> components;
+        for(auto p = path; p != npos; p = paths[p].parent)
+            components.push_back(paths[p].leaf);
+        std::unique_ptr<std::string> full(new std::string);
+        for(auto it = components.rbegin(); it != components.rend(); ++it) {
+            if(it != components.rbegin())
+                full->push_back(sep);
+            full->append(symbols[*it]);
+        }
+        bytes += full->size() + 1;
+        node.full = std::move(full);
+    }
+    return *node.full;
+}
+
+string_interner::stats string_interner::get_stats() const {
+    std::lock_guard<std::mutex> lock(mtx);
+    stats ret;
+    ret.symbols = symbols.size();
+    ret.paths = paths.size();
+    for(auto& p : paths)
+        if(p.full)
+            ++ret.materialized_paths;
+    ret.bytes = bytes + symbols.size() * (sizeof(std::string) + sizeof(id_type) + sizeof(symbol_key)) +
+                paths.size() * (sizeof(path_node) + sizeof(uint64_t) + sizeof(id_type));
+    return ret;
+}
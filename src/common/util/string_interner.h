@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_STRING_INTERNER_H_
+#define _UTIL_STRING_INTERNER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <nonstd/string_view.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief a thread-safe string interner
+ *
+ * The interner stores each distinct string once and hands out small ids which stay valid for the lifetime of the
+ * interner. Strings and their views are stable, so they can be kept by the caller.
+ *
+ * Hierarchical names (e.g. 'top.sub.signal') can be interned as paths: each path is a node referring to its parent
+ * path and the symbol id of its last name component. This way common prefixes and common leaf names are stored only
+ * once. The full name of a path is materialized on request only. The separator of the name components is fixed per
+ * interner.
+ *
+ * Callers recording many names below a common prefix should intern the prefix once and keep its id, children are
+ * then added using intern_child() or child_path_str() without splitting and hashing the prefix again.
+ */
+class string_interner {
+public:
+    using id_type = uint32_t;
+    //! the id denoting no string or path respectively the root of all paths
+    static constexpr id_type npos = std::numeric_limits<id_type>::max();
+    //! \brief statistics of the interner
+    struct stats {
+        size_t symbols{0};
+        size_t paths{0};
+        size_t materialized_paths{0};
+        size_t bytes{0};
+    };
+    /**
+     * @brief returns the interner shared by all SCC subsystems
+     */
+    static string_interner& get();
+
+    /**
+     * @brief constructs an interner
+     *
+     * @param separator the separator of the components of hierarchical names
+     */
+    explicit string_interner(char separator = '.')
+    : sep(separator) {}
+
+    string_interner(string_interner const&) = delete;
+
+    string_interner& operator=(string_interner const&) = delete;
+    /**
+     * @brief interns a string
+     *
+     * @param s the string
+     * @param len the length of the string
+     * @return the id of the string
+     */
+    id_type intern(char const* s, size_t len);
+    //! \brief interns a null terminated string
+    id_type intern(char const* s) { return intern(s, strlen(s)); }
+    //! \brief interns a string like object providing data() and size() (std::string, string_view)
+    template <typename STR> auto intern(STR const& s) -> decltype(s.data(), s.size(), id_type()) { return intern(s.data(), s.size()); }
+    /**
+     * @brief looks up a string without inserting it
+     *
+     * @param s the string
+     * @param len the length of the string
+     * @return the id of the string or npos if it is not known
+     */
+    id_type find(char const* s, size_t len) const;
+    //! \brief looks up a null terminated string without inserting it
+    id_type find(char const* s) const { return find(s, strlen(s)); }
+    //! \brief looks up a string like object providing data() and size() without inserting it
+    template <typename STR> auto find(STR const& s) const -> decltype(s.data(), s.size(), id_type()) { return find(s.data(), s.size()); }
+    //! \brief returns the string of a symbol id
+    std::string const& str(id_type id) const;
+    //! \brief returns a view of the string of a symbol id
+    nonstd::string_view view(id_type id) const { return str(id); }
+    //! \brief the separator of the components of hierarchical names
+    char separator() const { return sep; }
+    /**
+     * @brief interns a hierarchical name and all its prefixes
+     *
+     * @param name the hierarchical name
+     * @param len the length of the name
+     * @return the id of the path
+     */
+    id_type intern_path(char const* name, size_t len);
+    //! \brief interns a null terminated hierarchical name and all its prefixes
+    id_type intern_path(char const* name) { return intern_path(name, strlen(name)); }
+    //! \brief interns a hierarchical name given as string like object providing data() and size()
+    template <typename STR> auto intern_path(STR const& name) -> decltype(name.data(), name.size(), id_type()) {
+        return intern_path(name.data(), name.size());
+    }
+    /**
+     * @brief interns a child of an existing path
+     *
+     * @param parent the parent path or npos for a top-level name
+     * @param leaf the name of the child
+     * @return the id of the path
+     */
+    id_type intern_child(id_type parent, char const* leaf, size_t len);
+    //! \brief interns a null terminated child name of an existing path
+    id_type intern_child(id_type parent, char const* leaf) { return intern_child(parent, leaf, strlen(leaf)); }
+    //! \brief interns a child name given as string like object of an existing path
+    template <typename STR> auto intern_child(id_type parent, STR const& leaf) -> decltype(leaf.data(), leaf.size(), id_type()) {
+        return intern_child(parent, leaf.data(), leaf.size());
+    }
+    /**
+     * @brief interns a child of an existing path and returns its full hierarchical name, this needs a single lookup
+     *
+     * @param parent the parent path or npos for a top-level name
+     * @param leaf the name of the child
+     * @param len the length of the name of the child
+     * @return the full hierarchical name of the child
+     */
+    std::string const& child_path_str(id_type parent, char const* leaf, size_t len);
+    //! \brief interns a null terminated child name of an existing path and returns its full hierarchical name
+    std::string const& child_path_str(id_type parent, char const* leaf) { return child_path_str(parent, leaf, strlen(leaf)); }
+    //! \brief interns a child name given as string like object of an existing path and returns its full hierarchical name
+    template <typename STR> auto child_path_str(id_type parent, STR const& leaf) -> decltype(leaf.data(), leaf.size(), str(0)) {
+        return child_path_str(parent, leaf.data(), leaf.size());
+    }
+    /**
+     * @brief looks up a hierarchical name without inserting it
+     *
+     * @param name the hierarchical name
+     * @param len the length of the name
+     * @return the id of the path or npos if it is not known
+     */
+    id_type find_path(char const* name, size_t len) const;
+    //! \brief looks up a null terminated hierarchical name without inserting it
+    id_type find_path(char const* name) const { return find_path(name, strlen(name)); }
+    //! \brief looks up a hierarchical name given as string like object without inserting it
+    template <typename STR> auto find_path(STR const& name) const -> decltype(name.data(), name.size(), id_type()) {
+        return find_path(name.data(), name.size());
+    }
+    //! \brief returns the symbol ids of the name components of a path starting with the top-level name
+    std::vector<id_type> components(id_type path) const;
+    //! \brief returns the parent of a path, npos for top-level names
+    id_type parent(id_type path) const;
+    //! \brief returns the symbol id of the last component of a path
+    id_type leaf(id_type path) const;
+    /**
+     * @brief returns the full hierarchical name of a path, the string is created once upon the first request
+     *
+     * @param path the path id
+     */
+    std::string const& path_str(id_type path);
+    //! \brief returns the current statistics
+    stats get_stats() const;
+
+private:
+    struct path_node {
+        id_type parent;
+        id_type leaf;
+        std::unique_ptr<std::string> full;
+    };
+    struct symbol_key {
+        char const* data;
+        size_t size;
+        bool operator==(symbol_key const& o) const { return size == o.size && !memcmp(data, o.data, size); }
+    };
+    struct symbol_hash {
+        size_t operator()(symbol_key const& k) const {
+            // FNV-1a
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for(size_t i = 0; i < k.size; ++i)
+                h = (h ^ static_cast<uint8_t>(k.data[i])) * 0x100000001b3ULL;
+            return static_cast<size_t>(h);
+        }
+    };
+    static inline uint64_t path_key(id_type parent, id_type leaf) { return (static_cast<uint64_t>(parent) << 32) | leaf; }
+    id_type intern_locked(char const* s, size_t len);
+    id_type find_locked(char const* s, size_t len) const;
+    id_type intern_path_locked(id_type parent, id_type leaf);
+    std::string const& path_str_locked(id_type path);
+
+    char const sep;
+    mutable std::mutex mtx;
+    std::deque<std::string> symbols;
+    std::unordered_map<symbol_key, id_type, symbol_hash> symbol_ids;
+    std::deque<path_node> paths;
+    std::unordered_map<uint64_t, id_type> path_ids;
+    size_t bytes{0};
+};
+} // namespace util
+/**@}*/
+#endif /* _UTIL_STRING_INTERNER_H_ */
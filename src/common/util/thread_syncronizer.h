@@ -30,6 +30,9 @@
 namespace util {
 /**
  * @brief executes a function syncronized in another thread
+ *
+ * To inject work into a running SystemC simulation scc::async_channel should be used as it wakes the kernel without
+ * polling.
  */
 class thread_syncronizer {
 private:
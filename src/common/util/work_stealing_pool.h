@@ -0,0 +1,492 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _COMMON_UTIL_WORK_STEALING_POOL_H_
+#define _COMMON_UTIL_WORK_STEALING_POOL_H_
+
+#include "small_task.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief the lock-free work stealing deque of Chase and Lev (in the formulation of Le et al., PPoPP 2013)
+ *
+ * The owner pushes and pops at the bottom, any other thread steals from the top. The ring buffer grows on demand,
+ * replaced buffers are kept until the deque is destroyed since thieves might still read them.
+ *
+ * @tparam T a trivially copyable element type, usually a pointer
+ */
+template <typename T> class chase_lev_deque {
+    static_assert(std::is_trivially_copyable<T>::value, "chase_lev_deque requires a trivially copyable type");
+
+    struct ring {
+        explicit ring(int64_t cap)
+        : mask(cap - 1)
+        , data(new std::atomic<T>[static_cast<size_t>(cap)]) {}
+        int64_t capacity() const { return mask + 1; }
+        T get(int64_t i) const { return data[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T v) { data[i & mask].store(v, std::memory_order_relaxed); }
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> data;
+    };
+
+public:
+    /**
+     * @brief the constructor
+     *
+     * @param capacity the initial capacity, rounded up to a power of two
+     */
+    explicit chase_lev_deque(int64_t capacity = 256) {
+        int64_t cap = 2;
+        while(cap < capacity)
+            cap <<= 1;
+        rings.emplace_back(new ring(cap));
+        buffer.store(rings.back().get(), std::memory_order_relaxed);
+    }
+    //! \brief adds an element at the bottom, owner only
+    void push(T v) {
+        auto b = bottom.load(std::memory_order_relaxed);
+        auto t = top.load(std::memory_order_acquire);
+        auto* a = buffer.load(std::memory_order_relaxed);
+        if(b - t > a->capacity() - 1)
+            a = grow(a, b, t);
+        a->put(b, v);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    //! \brief removes an element from the bottom, owner only
+    bool pop(T& v) {
+        auto b = bottom.load(std::memory_order_relaxed) - 1;
+        auto* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+        if(t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        v = a->get(b);
+        if(t == b) {
+            // last element, compete with the thieves
+            auto won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+    //! \brief removes an element from the top, any thread. Returns false if the deque was empty or the race was lost
+    bool steal(T& v) {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = bottom.load(std::memory_order_acquire);
+        if(t >= b)
+            return false;
+        v = buffer.load(std::memory_order_acquire)->get(t);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+    //! \brief returns true if the deque appears to be empty
+    bool empty() const { return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed); }
+
+private:
+    ring* grow(ring* a, int64_t b, int64_t t) {
+        rings.emplace_back(new ring(a->capacity() * 2));
+        auto* n = rings.back().get();
+        for(auto i = t; i < b; ++i)
+            n->put(i, a->get(i));
+        buffer.store(n, std::memory_order_release);
+        return n;
+    }
+
+    // the padding keeps top and bottom in separate cache lines
+    std::atomic<int64_t> top{0};
+    char pad0[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<int64_t> bottom{0};
+    char pad1[64 - sizeof(std::atomic<int64_t>)];
+    std::atomic<ring*> buffer{nullptr};
+    std::vector<std::unique_ptr<ring>> rings;
+};
+/**
+ * @brief a bounded lock-free multi-producer multi-consumer queue (D. Vyukov)
+ *
+ * @tparam T a default constructible and movable element type, elements are moved into and out of the slots
+ */
+template <typename T> class mpmc_bounded_queue {
+    struct cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+public:
+    /**
+     * @brief the constructor
+     *
+     * @param capacity the capacity, rounded up to a power of two
+     */
+    explicit mpmc_bounded_queue(size_t capacity = 4096) {
+        size_t cap = 2;
+        while(cap < capacity)
+            cap <<= 1;
+        mask = cap - 1;
+        cells.reset(new cell[cap]);
+        for(size_t i = 0; i < cap; ++i)
+            cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    //! \brief adds a copy of an element, returns false if the queue is full
+    bool push(T const& v) { return enqueue(v); }
+    //! \brief moves an element into the queue, returns false and leaves v untouched if the queue is full
+    bool push(T&& v) { return enqueue(std::move(v)); }
+    //! \brief removes an element, returns false if the queue is empty
+    bool pop(T& v) {
+        auto pos = dequeue_pos.load(std::memory_order_relaxed);
+        for(;;) {
+            auto& c = cells[pos & mask];
+            auto diff = static_cast<intptr_t>(c.seq.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos + 1);
+            if(diff == 0) {
+                if(dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    v = std::move(c.data);
+                    c.seq.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0)
+                return false;
+            else
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    //! \brief returns true if the queue appears to be empty
+    bool empty() const { return enqueue_pos.load(std::memory_order_relaxed) == dequeue_pos.load(std::memory_order_relaxed); }
+
+private:
+    template <typename U> bool enqueue(U&& v) {
+        auto pos = enqueue_pos.load(std::memory_order_relaxed);
+        for(;;) {
+            auto& c = cells[pos & mask];
+            auto diff = static_cast<intptr_t>(c.seq.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+            if(diff == 0) {
+                if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.data = std::forward<U>(v);
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0)
+                return false;
+            else
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::unique_ptr<cell[]> cells;
+    size_t mask{0};
+    // the padding keeps producers and consumers in separate cache lines
+    char pad0[64];
+    std::atomic<size_t> enqueue_pos{0};
+    char pad1[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_pos{0};
+};
+/**
+ * @brief a reusable spinning barrier for a fixed number of threads
+ */
+class barrier {
+public:
+    //! \brief the constructor taking the number of participating threads
+    explicit barrier(size_t count)
+    : count(count) {}
+    //! \brief blocks until all participating threads arrived
+    void arrive_and_wait() {
+        auto gen = generation.load(std::memory_order_acquire);
+        if(arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        for(unsigned spins = 0; generation.load(std::memory_order_acquire) == gen; ++spins)
+            if(spins > 64)
+                std::this_thread::yield();
+    }
+
+private:
+    const size_t count;
+    std::atomic<size_t> arrived{0};
+    char pad[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> generation{0};
+};
+/**
+ * @brief a thread pool with per-worker work stealing deques
+ *
+ * Tasks submitted by a worker are pushed to its own deque, tasks from other threads go through a lock-free injection
+ * queue. Idle workers steal from the others and go to sleep only after spinning for a while. The injection queue holds
+ * the tasks by value while the deques hold pointers to task objects which are recycled in the thread local caches of
+ * the workers. Hence submitting a task with captures of up to 64 bytes does not allocate once the caches are warm.
+ * Tasks must not throw.
+ */
+class work_stealing_pool {
+public:
+    /**
+     * @brief the constructor starting the worker threads
+     *
+     * @param threads the number of worker threads
+     */
+    explicit work_stealing_pool(unsigned threads = std::max(1U, std::thread::hardware_concurrency())) {
+        workers.reserve(threads);
+        for(unsigned i = 0; i < threads; ++i)
+            workers.emplace_back(new worker);
+        for(unsigned i = 0; i < threads; ++i)
+            workers[i]->thread = std::thread([this, i] { worker_loop(i); });
+    }
+    //! \brief the destructor finishing all pending tasks and joining the workers
+    ~work_stealing_pool() {
+        wait();
+        stop.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> l(sleep_mtx);
+            sleep_cv.notify_all();
+        }
+        for(auto& w : workers)
+            w->thread.join();
+    }
+
+    work_stealing_pool(work_stealing_pool const&) = delete;
+    work_stealing_pool& operator=(work_stealing_pool const&) = delete;
+    //! \brief the number of worker threads
+    size_t size() const { return workers.size(); }
+    /**
+     * @brief submits a task without a way to wait for its result (fire and forget)
+     *
+     * @param f the callable
+     */
+    template <typename F> void execute(F&& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        auto& ctx = context();
+        if(ctx.pool == this) {
+            auto* t = alloc_task();
+            *t = small_task(std::forward<F>(f));
+            workers[ctx.index]->deque.push(t);
+        } else {
+            small_task t(std::forward<F>(f));
+            while(!injection.push(std::move(t))) // the queue is full, help to drain it
+                if(!run_one(NO_WORKER))
+                    std::this_thread::yield();
+        }
+        wake_one();
+    }
+    /**
+     * @brief calls f(i) for each i in [begin, end) in parallel and returns once all calls have finished, the calling
+     * thread takes part in the work
+     *
+     * @param begin the first index
+     * @param end the index after the last
+     * @param f the function to call
+     * @param grain the number of indexes per task, 0 selects a value yielding about 4 tasks per thread
+     */
+    template <typename F> void parallel_for(size_t begin, size_t end, F const& f, size_t grain = 0) {
+        if(begin >= end)
+            return;
+        auto n = end - begin;
+        if(!grain)
+            grain = std::max<size_t>(1, n / (4 * (workers.size() + 1)));
+        std::atomic<size_t> remaining{(n + grain - 1) / grain - 1};
+        for(auto s = begin + grain; s < end; s += grain) {
+            auto e = std::min(end, s + grain);
+            execute([&f, &remaining, s, e]() {
+                for(auto i = s; i < e; ++i)
+                    f(i);
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        for(auto i = begin; i < std::min(end, begin + grain); ++i)
+            f(i);
+        help_while([&remaining]() { return remaining.load(std::memory_order_acquire) != 0; });
+    }
+    /**
+     * @brief waits until all submitted tasks have finished, the calling thread takes part in the work
+     *
+     * It must not be called from a task of this pool since the calling task itself is pending and the call would
+     * never return, use parallel_for() to wait for sub-tasks instead.
+     */
+    void wait() {
+        assert(context().running != this && "work_stealing_pool::wait() must not be called from one of its tasks");
+        help_while([this]() { return pending.load(std::memory_order_acquire) != 0; });
+    }
+
+private:
+    static constexpr unsigned NO_WORKER = ~0U;
+
+    struct worker {
+        chase_lev_deque<small_task*> deque;
+        std::thread thread;
+    };
+
+    struct thread_context {
+        work_stealing_pool* pool{nullptr};
+        unsigned index{0};
+        // the pool whose task is being executed by this thread
+        work_stealing_pool* running{nullptr};
+    };
+
+    struct task_cache {
+        std::vector<small_task*> tasks;
+        ~task_cache() {
+            for(auto* t : tasks)
+                delete t;
+        }
+    };
+
+    static thread_context& context() {
+        static thread_local thread_context ctx;
+        return ctx;
+    }
+
+    // task objects are allocated by workers only, they are freed by the worker running them or by a thread helping in
+    // wait() or parallel_for(). Only workers keep freed tasks as they are the only ones to allocate.
+    static small_task* alloc_task() {
+        auto& c = cache();
+        if(c.tasks.empty())
+            return new small_task;
+        auto* t = c.tasks.back();
+        c.tasks.pop_back();
+        return t;
+    }
+
+    void free_task(small_task* t) {
+        t->reset();
+        auto& c = cache();
+        if(context().pool == this && c.tasks.size() < 1024)
+            c.tasks.push_back(t);
+        else
+            delete t;
+    }
+
+    static task_cache& cache() {
+        static thread_local task_cache c;
+        return c;
+    }
+
+    template <typename COND> void help_while(COND cond) {
+        auto& ctx = context();
+        auto self = ctx.pool == this ? ctx.index : NO_WORKER;
+        for(unsigned spins = 0; cond();)
+            if(run_one(self))
+                spins = 0;
+            else if(++spins > 64)
+                std::this_thread::yield();
+    }
+
+    bool run_one(unsigned self) {
+        small_task* t = nullptr;
+        if(self != NO_WORKER && workers[self]->deque.pop(t))
+            return run(t);
+        small_task injected;
+        if(injection.pop(injected)) {
+            execute_task(injected);
+            injected.reset();
+            pending.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+        auto n = workers.size();
+        auto start = self != NO_WORKER ? self + 1 : static_cast<size_t>(steal_start.fetch_add(1, std::memory_order_relaxed));
+        for(size_t i = 0; i < n; ++i) {
+            auto victim = (start + i) % n;
+            if(victim != self && workers[victim]->deque.steal(t))
+                return run(t);
+        }
+        return false;
+    }
+
+    bool run(small_task* t) {
+        execute_task(*t);
+        free_task(t);
+        pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void execute_task(small_task& t) {
+        auto& ctx = context();
+        auto* outer = ctx.running;
+        ctx.running = this;
+        t();
+        ctx.running = outer;
+    }
+
+    bool has_work() const {
+        if(!injection.empty())
+            return true;
+        for(auto& w : workers)
+            if(!w->deque.empty())
+                return true;
+        return false;
+    }
+
+    void wake_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleepers.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> l(sleep_mtx);
+            sleep_cv.notify_one();
+        }
+    }
+
+    void worker_loop(unsigned idx) {
+        auto& ctx = context();
+        ctx.pool = this;
+        ctx.index = idx;
+        unsigned idle = 0;
+        while(!stop.load(std::memory_order_acquire)) {
+            if(run_one(idx)) {
+                idle = 0;
+            } else if(++idle < 256) {
+                std::this_thread::yield();
+            } else {
+                std::unique_lock<std::mutex> l(sleep_mtx);
+                sleepers.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                // the timeout guards against a missed notification
+                if(!has_work() && !stop.load(std::memory_order_relaxed))
+                    sleep_cv.wait_for(l, std::chrono::milliseconds(1));
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                idle = 0;
+            }
+        }
+        ctx.pool = nullptr;
+    }
+
+    std::vector<std::unique_ptr<worker>> workers;
+    mpmc_bounded_queue<small_task> injection;
+    std::atomic<size_t> pending{0};
+    std::atomic<unsigned> steal_start{0};
+    std::atomic<unsigned> sleepers{0};
+    std::atomic<bool> stop{false};
+    std::mutex sleep_mtx;
+    std::condition_variable sleep_cv;
+};
+} // namespace util
+/**@}*/
+#endif /* _COMMON_UTIL_WORK_STEALING_POOL_H_ */
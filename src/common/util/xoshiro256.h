@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _UTIL_XOSHIRO256_H_
+#define _UTIL_XOSHIRO256_H_
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * \ingroup scc-common
+ */
+/**@{*/
+//! @brief SCC common utilities
+namespace util {
+/**
+ * @brief the xoshiro256** pseudo random number generator (D. Blackman, S. Vigna)
+ *
+ * It satisfies the UniformRandomBitGenerator requirements and can be used with the distributions of <random>. The
+ * state of 32 bytes is derived from the 64bit seed using splitmix64, the same seed always yields the same sequence.
+ */
+class xoshiro256ss {
+public:
+    using result_type = uint64_t;
+
+    static constexpr uint64_t default_seed = 5489u;
+
+    explicit xoshiro256ss(uint64_t seed_value = default_seed) { seed(seed_value); }
+
+    void seed(uint64_t seed_value) {
+        for(auto& e : s) {
+            seed_value += 0x9e3779b97f4a7c15ULL;
+            auto z = seed_value;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            e = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()() {
+        auto const result = rotl(s[1] * 5, 7) * 9;
+        auto const t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void discard(unsigned long long z) {
+        for(; z; --z)
+            (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t s[4];
+};
+} // namespace util
+/**@}*/
+#endif /* _UTIL_XOSHIRO256_H_ */
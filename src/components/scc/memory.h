@@ -22,14 +22,20 @@
 #define SC_INCLUDE_DYNAMIC_PROCESSES
 #endif
 
-#include <numeric>
+#include <algorithm>
+#include <queue>
+#include <scc/cached_param.h>
 #include <scc/mt19937_rng.h>
 #include <scc/report.h>
 #include <scc/signal_opt_ports.h>
 #include <scc/utilities.h>
 #include <tlm.h>
 #include <tlm/scc/target_mixin.h>
+#include <util/image_loader.h>
+#include <util/masked_copy.h>
+#include <util/mem_fill.h>
 #include <util/sparse_array.h>
+#include <util/sparse_array_io.h>
 
 namespace scc {
 /**
@@ -39,12 +45,32 @@ namespace scc {
  * This model uses the \ref util::sparse_array as backing store. Therefore it can have an arbitrary size since only
  * pages for accessed addresses are allocated.
  *
+ * Byte enables and streaming widths smaller than the data length are supported natively. Masked accesses are copied
+ * using a vectorized blend (see util::masked_copy) so that strobed bus traffic does not need to be split.
+ *
+ * Besides the blocking interface the memory implements nb_transport_fw natively. Requests are accepted into a
+ * pipeline of configurable depth, each access occupies one of a number of interleaved banks and a change of direction
+ * within a bank adds a turnaround delay. Responses are issued in order of their completion time by a single method
+ * process triggered by one event, hence no process is created per transaction.
+ *
+ * Besides the TLM interfaces the contents can be accessed in bulk (read, write, fill, compare of arbitrary length) and
+ * images (ELF, Intel HEX, raw binaries) can be loaded directly into the pages.
+ *
+ * The contents can be saved to and restored from LZ4 compressed snapshot files (pages are decompressed upon their first
+ * access) as well as forked in memory by sharing the pages copy-on-write.
+ *
+ * Reads from locations which have never been written return data according to the fill policy (see \ref fill_type).
+ * The default draws per byte random numbers from scc::MT19937 as before. All other policies yield data which is a
+ * function of the address only, hence it is reproducible and independent of the order and size of the accesses.
+ *
  * TODO: add some more attributes/parameters to configure access time and type (DMI allowed, read only, etc)
  *
  * @tparam SIZE size of the memery
  * @tparam BUSWIDTH bus width of the socket
  */
 template <unsigned long long SIZE, unsigned BUSWIDTH = LT> class memory : public sc_core::sc_module {
+    SC_HAS_PROCESS(memory);
+
 public:
     //! the target socket to connect to TLM
     tlm::scc::target_mixin<tlm::tlm_target_socket<BUSWIDTH>> target{"ts"};
@@ -78,24 +104,282 @@ public:
      * @param cb the callback function or functor
      */
     void set_dmi_callback(std::function<int(memory<SIZE, BUSWIDTH>&, tlm::tlm_generic_payload&, tlm::tlm_dmi&)> cb) { dmi_cb = cb; }
+    //! the type of a memory page
+    using page_type = typename util::sparse_array<uint8_t, SIZE>::page_type;
+    /**
+     * @brief reads a range of arbitrary length, unallocated memory is returned according to the fill policy
+     *
+     * @param addr the start address
+     * @param data the destination buffer
+     * @param len the number of bytes
+     */
+    void read(uint64_t addr, uint8_t* data, uint64_t len) {
+        if(!check_range(addr, len))
+            return;
+        access_pages([this, addr, len, &data]() {
+            mem.for_each_page_run(addr, len, [this, &data](uint64_t a, page_type const* p, uint64_t offs, uint64_t run) {
+                if(p)
+                    memcpy(data, p->data() + offs, run);
+                else
+                    fill_unallocated(data, a, run);
+                data += run;
+            });
+        });
+    }
+    /**
+     * @brief writes a range of arbitrary length
+     *
+     * @param addr the start address
+     * @param data the source buffer
+     * @param len the number of bytes
+     */
+    void write(uint64_t addr, uint8_t const* data, uint64_t len) {
+        if(check_range(addr, len))
+            access_pages([this, addr, data, len]() { mem.write(addr, data, len); });
+    }
+    /**
+     * @brief sets a range of arbitrary length to a value
+     *
+     * @param addr the start address
+     * @param val the value
+     * @param len the number of bytes
+     */
+    void fill(uint64_t addr, uint8_t val, uint64_t len) {
+        if(check_range(addr, len))
+            access_pages([this, addr, val, len]() { mem.fill(addr, val, len); });
+    }
+    /**
+     * @brief compares a range of arbitrary length with a buffer
+     *
+     * @param addr the start address
+     * @param data the data to compare with
+     * @param len the number of bytes
+     * @return true if the memory contents (as returned by read()) equal the data
+     */
+    bool compare(uint64_t addr, uint8_t const* data, uint64_t len) {
+        if(!check_range(addr, len))
+            return false;
+        bool equal = true;
+        auto ok = access_pages([this, addr, len, &data, &equal]() {
+            mem.for_each_page_run(addr, len, [this, &data, &equal](uint64_t a, page_type const* p, uint64_t offs, uint64_t run) {
+                if(p)
+                    equal = equal && !memcmp(data, p->data() + offs, run);
+                else {
+                    uint8_t buf[1024];
+                    for(uint64_t done = 0; equal && done < run; done += sizeof(buf)) {
+                        auto chunk = std::min<uint64_t>(sizeof(buf), run - done);
+                        fill_unallocated(buf, a + done, chunk);
+                        equal = !memcmp(data + done, buf, chunk);
+                    }
+                }
+                data += run;
+            });
+        });
+        return ok && equal;
+    }
+    /**
+     * @brief loads an image file (ELF, Intel HEX or raw binary) directly into the memory pages
+     *
+     * @param file_name the name of the file
+     * @param offset the load address of raw binaries
+     * @return the number of bytes loaded, 0 if the image could not be loaded or does not fit into the memory
+     */
+    uint64_t load_image(std::string const& file_name, uint64_t offset = 0) {
+        try {
+            return util::image_loader::load(
+                file_name,
+                [this](uint64_t addr, uint64_t len) {
+                    if(addr >= SIZE)
+                        throw std::runtime_error("image exceeds the memory size");
+                    // the last page may extend beyond SIZE
+                    return mem.write_span(addr, std::min<uint64_t>(len, SIZE - addr));
+                },
+                offset);
+        } catch(std::runtime_error& e) {
+            SC_REPORT_ERROR("scc::memory", (file_name + ": " + e.what()).c_str());
+        }
+        return 0;
+    }
+    //! the type of an in-memory snapshot of the contents
+    using snapshot_type = typename util::sparse_array<uint8_t, SIZE>::snapshot_type;
+    /**
+     * @brief creates an in-memory snapshot of the contents, the pages are shared copy-on-write
+     *
+     * @return the snapshot
+     */
+    snapshot_type snapshot() {
+        invalidate_dmi();
+        return mem.snapshot();
+    }
+    /**
+     * @brief replaces the contents by a snapshot, the pages are shared copy-on-write
+     *
+     * @param snapshot the snapshot to restore
+     */
+    void restore(snapshot_type const& snapshot) {
+        invalidate_dmi();
+        mem.restore(snapshot);
+    }
+    /**
+     * @brief writes the allocated pages to a LZ4 compressed snapshot file
+     *
+     * @param file_name the name of the file
+     */
+    void save_snapshot(std::string const& file_name) {
+        invalidate_dmi();
+        try {
+            util::save_snapshot(mem, file_name);
+        } catch(std::runtime_error& e) {
+            SC_REPORT_ERROR("scc::memory", e.what());
+        }
+    }
+    /**
+     * @brief replaces the contents by a snapshot file, the pages are decompressed upon their first access
+     *
+     * A page which cannot be decompressed is reported as error upon its access, a transaction accessing it fails.
+     *
+     * @param file_name the name of the file
+     */
+    void load_snapshot(std::string const& file_name) {
+        invalidate_dmi();
+        try {
+            util::load_snapshot(mem, file_name);
+        } catch(std::runtime_error& e) {
+            SC_REPORT_ERROR("scc::memory", e.what());
+        }
+    }
     /**
      * read response delay
      */
-    cci::cci_param<sc_core::sc_time> rd_resp_delay{"rd_resp_delay", sc_core::SC_ZERO_TIME};
+    scc::cached_param<sc_core::sc_time> rd_resp_delay{"rd_resp_delay", sc_core::SC_ZERO_TIME};
     /**
      * write response delay
      */
-    cci::cci_param<sc_core::sc_time> wr_resp_delay{"wr_resp_delay", sc_core::SC_ZERO_TIME};
+    scc::cached_param<sc_core::sc_time> wr_resp_delay{"wr_resp_delay", sc_core::SC_ZERO_TIME};
     /**
      * read response delay in clock cycles
      */
-    cci::cci_param<unsigned> rd_resp_clk_delay{"rd_resp_clk_delay", 0};
+    scc::cached_param<unsigned> rd_resp_clk_delay{"rd_resp_clk_delay", 0};
     /**
      * write response delay in clock cycles
      */
-    cci::cci_param<unsigned> wr_resp_clk_delay{"wr_resp_clk_delay", 0};
+    scc::cached_param<unsigned> wr_resp_clk_delay{"wr_resp_clk_delay", 0};
+    //! the fill policies for reads of unallocated memory
+    enum fill_type {
+        FILL_RANDOM = 0,    //!< pseudo random data from a counter based generator seeded by fill_seed
+        FILL_ZERO = 1,      //!< all bytes are zero
+        FILL_PATTERN = 2,   //!< the 8 byte fill_pattern repeated, aligned to the address
+        FILL_ADDR_HASH = 3, //!< a hash of the address independent of the instance
+        FILL_MT19937 = 4    //!< per byte random data from scc::MT19937 (depends on the access order), the default
+    };
+    /**
+     * the fill policy for reads of unallocated memory, one of \ref fill_type
+     */
+    scc::cached_param<unsigned> fill_policy{"fill_policy", FILL_MT19937,
+                                            "fill policy for unallocated memory: 0=random, 1=zero, 2=pattern, 3=address hash, 4=MT19937"};
+    /**
+     * the pattern used by the pattern fill policy
+     */
+    scc::cached_param<uint64_t> fill_pattern{"fill_pattern", 0xdeadbeefdeadbeefULL};
+    /**
+     * the seed of the random fill policy, defaults to a value derived from the instance name
+     */
+    scc::cached_param<uint64_t> fill_seed{"fill_seed", util::seed_from_name(name())};
+    /**
+     * the number of transactions the non-blocking interface accepts before the responses have been completed
+     */
+    scc::cached_param<unsigned> pipeline_depth{"pipeline_depth", 8};
+    /**
+     * the number of banks, they are interleaved with the width of the bus
+     */
+    scc::cached_param<unsigned> bank_count{"bank_count", 1};
+    /**
+     * time a bank is occupied by an access of the non-blocking interface
+     */
+    scc::cached_param<sc_core::sc_time> bank_busy_delay{"bank_busy_delay", sc_core::SC_ZERO_TIME};
+    /**
+     * clock cycles a bank is occupied by an access of the non-blocking interface
+     */
+    scc::cached_param<unsigned> bank_busy_clk_delay{"bank_busy_clk_delay", 1};
+    /**
+     * delay if a bank changes between read and write accesses
+     */
+    scc::cached_param<sc_core::sc_time> rw_turnaround_delay{"rw_turnaround_delay", sc_core::SC_ZERO_TIME};
+    /**
+     * delay in clock cycles if a bank changes between read and write accesses
+     */
+    scc::cached_param<unsigned> rw_turnaround_clk_delay{"rw_turnaround_clk_delay", 0};
 
 protected:
+    // subclasses overriding end_of_elaboration() without calling it still get the clock period since clk_period then
+    // reads clk_i upon each access
+    void end_of_elaboration() override { clk_period.start(); }
+    //! the mirrored value of clk_i
+    scc::cached_port_value<sc_core::sc_time> clk_period{clk_i};
+    //! the delay of a read access
+    sc_core::sc_time rd_delay() const {
+        return clk_period.valid() ? clk_period.get() * rd_resp_clk_delay.get_value() : rd_resp_delay.get_value();
+    }
+    //! the delay of a write access
+    sc_core::sc_time wr_delay() const {
+        return clk_period.valid() ? clk_period.get() * wr_resp_clk_delay.get_value() : wr_resp_delay.get_value();
+    }
+    //! the time of a delay given either as time or in clock cycles
+    sc_core::sc_time delay_of(scc::cached_param<sc_core::sc_time> const& t, scc::cached_param<unsigned> const& cycles) const {
+        return clk_period.valid() ? clk_period.get() * cycles.get_value() : t.get_value();
+    }
+    //! handle the forward path of the non-blocking interface
+    tlm::tlm_sync_enum nb_transport_fw(tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& t);
+    //! executes an accepted request and schedules its response
+    void accept_request(tlm::tlm_generic_payload& trans, sc_core::sc_time const& t);
+    //! finishes a response and accepts a stalled request if any
+    void complete_response(tlm::tlm_generic_payload& trans);
+    //! the method process sending END_REQ and BEGIN_RESP on the backward path
+    void at_resp_cb();
+    //! a scheduled response
+    struct at_resp_entry {
+        sc_core::sc_time time;
+        uint64_t seq;
+        tlm::tlm_generic_payload* trans;
+        bool operator>(at_resp_entry const& o) const { return time > o.time || (time == o.time && seq > o.seq); }
+    };
+    //! the state of a bank
+    struct at_bank_state {
+        sc_core::sc_time free_at;
+        tlm::tlm_command last_cmd{tlm::TLM_IGNORE_COMMAND};
+    };
+    std::priority_queue<at_resp_entry, std::vector<at_resp_entry>, std::greater<at_resp_entry>> at_resp_queue;
+    std::vector<at_bank_state> at_banks;
+    sc_core::sc_event at_evt;
+    tlm::tlm_generic_payload* at_stalled_req{nullptr};
+    tlm::tlm_generic_payload* at_end_req{nullptr};
+    tlm::tlm_generic_payload* at_resp_in_progress{nullptr};
+    unsigned at_outstanding{0};
+    uint64_t at_seq{0};
+    //! checks that a range lies within the memory
+    bool check_range(uint64_t addr, uint64_t len) const {
+        if(addr <= SIZE && len <= SIZE - addr)
+            return true;
+        SC_REPORT_ERROR("scc::memory", "bulk access exceeds memory size");
+        return false;
+    }
+    //! runs an access to the pages, a page of a loaded snapshot which cannot be decompressed is reported as error
+    template <typename FUNC> bool access_pages(FUNC f) {
+        try {
+            f();
+            return true;
+        } catch(std::runtime_error& e) {
+            SC_REPORT_ERROR("scc::memory", e.what());
+            return false;
+        }
+    }
+    //! revokes all DMI pointers as pages may become shared or replaced
+    void invalidate_dmi() {
+        if(sc_core::sc_is_running())
+            target->invalidate_direct_mem_ptr(0, SIZE - 1);
+    }
+    //! fills len bytes at ptr with the data of unallocated memory at address addr
+    void fill_unallocated(uint8_t* ptr, uint64_t addr, size_t len) const;
     //! the real memory structure
     util::sparse_array<uint8_t, SIZE> mem;
 
@@ -104,6 +388,8 @@ public:
     int handle_operation(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay);
     //! handle the dmi functionality
     bool handle_dmi(tlm::tlm_generic_payload& gp, tlm::tlm_dmi& dmi_data);
+    //! calls f(address, data offset, length) for each part of an access which lies within a single page
+    template <typename FUNC> void for_each_page_segment(uint64_t adr, unsigned len, unsigned wid, FUNC f);
     std::function<int(memory<SIZE, BUSWIDTH>&, tlm::tlm_generic_payload&, sc_core::sc_time& delay)> operation_cb;
     std::function<int(memory<SIZE, BUSWIDTH>&, tlm::tlm_generic_payload&, tlm::tlm_dmi&)> dmi_cb;
 };
@@ -122,6 +408,102 @@ memory<SIZE, BUSWIDTH>::memory(const sc_core::sc_module_name& nm)
     target.register_get_direct_mem_ptr([this](tlm::tlm_generic_payload& gp, tlm::tlm_dmi& dmi_data) -> bool {
         return dmi_cb ? dmi_cb(*this, gp, dmi_data) : handle_dmi(gp, dmi_data);
     });
+    target.register_nb_transport_fw([this](tlm::tlm_generic_payload& gp, tlm::tlm_phase& phase, sc_core::sc_time& t) -> tlm::tlm_sync_enum {
+        return nb_transport_fw(gp, phase, t);
+    });
+    SC_METHOD(at_resp_cb);
+    sensitive << at_evt;
+    dont_initialize();
+}
+
+template <unsigned long long SIZE, unsigned BUSWIDTH>
+tlm::tlm_sync_enum memory<SIZE, BUSWIDTH>::nb_transport_fw(tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_core::sc_time& t) {
+    if(phase == tlm::BEGIN_REQ) {
+        if(trans.has_mm())
+            trans.acquire();
+        if(at_outstanding >= std::max(1U, pipeline_depth.get_value())) {
+            // the pipeline is full, END_REQ is sent once a response has been completed
+            at_stalled_req = &trans;
+            return tlm::TLM_ACCEPTED;
+        }
+        accept_request(trans, t);
+        phase = tlm::END_REQ;
+        return tlm::TLM_UPDATED;
+    } else if(phase == tlm::END_RESP) {
+        if(&trans != at_resp_in_progress) {
+            SC_REPORT_ERROR("TLM-2", "END_RESP received for a transaction without response in progress");
+            return tlm::TLM_COMPLETED;
+        }
+        at_resp_in_progress = nullptr;
+        complete_response(trans);
+        at_evt.notify(t);
+        return tlm::TLM_COMPLETED;
+    }
+    SC_REPORT_ERROR("TLM-2", "illegal phase received by memory");
+    return tlm::TLM_COMPLETED;
+}
+
+template <unsigned long long SIZE, unsigned BUSWIDTH>
+void memory<SIZE, BUSWIDTH>::accept_request(tlm::tlm_generic_payload& trans, sc_core::sc_time const& t) {
+    if(at_banks.size() != std::max(1U, bank_count.get_value()))
+        at_banks.resize(std::max(1U, bank_count.get_value()));
+    auto const now = sc_core::sc_time_stamp();
+    auto const interleave = BUSWIDTH >= 8 ? BUSWIDTH / 8 : 8;
+    auto& bank = at_banks[(trans.get_address() / interleave) % at_banks.size()];
+    auto start = std::max(now + t, bank.free_at);
+    if(bank.last_cmd != tlm::TLM_IGNORE_COMMAND && bank.last_cmd != trans.get_command())
+        start += delay_of(rw_turnaround_delay, rw_turnaround_clk_delay);
+    bank.free_at = start + delay_of(bank_busy_delay, bank_busy_clk_delay);
+    bank.last_cmd = trans.get_command();
+    // the data is transferred upon acceptance, the access delay determines the response time
+    sc_core::sc_time delay;
+    operation_cb ? operation_cb(*this, trans, delay) : handle_operation(trans, delay);
+    auto const resp_time = std::max(start + delay, bank.free_at);
+    at_resp_queue.push({resp_time, at_seq++, &trans});
+    at_outstanding++;
+    at_evt.notify(resp_time - now);
+}
+
+template <unsigned long long SIZE, unsigned BUSWIDTH> void memory<SIZE, BUSWIDTH>::complete_response(tlm::tlm_generic_payload& trans) {
+    at_outstanding--;
+    if(trans.has_mm())
+        trans.release();
+    if(at_stalled_req) {
+        at_end_req = at_stalled_req;
+        at_stalled_req = nullptr;
+        accept_request(*at_end_req, sc_core::SC_ZERO_TIME);
+    }
+}
+
+template <unsigned long long SIZE, unsigned BUSWIDTH> void memory<SIZE, BUSWIDTH>::at_resp_cb() {
+    auto const now = sc_core::sc_time_stamp();
+    if(at_end_req) {
+        auto* trans = at_end_req;
+        at_end_req = nullptr;
+        tlm::tlm_phase phase{tlm::END_REQ};
+        sc_core::sc_time t;
+        target->nb_transport_bw(*trans, phase, t);
+    }
+    while(!at_resp_in_progress && !at_resp_queue.empty()) {
+        auto const entry = at_resp_queue.top();
+        if(entry.time > now) {
+            at_evt.notify(entry.time - now);
+            return;
+        }
+        at_resp_queue.pop();
+        tlm::tlm_phase phase{tlm::BEGIN_RESP};
+        sc_core::sc_time t;
+        auto ret = target->nb_transport_bw(*entry.trans, phase, t);
+        if(ret == tlm::TLM_COMPLETED || (ret == tlm::TLM_UPDATED && phase == tlm::END_RESP)) {
+            complete_response(*entry.trans);
+            if(at_end_req || t > sc_core::SC_ZERO_TIME) {
+                // send END_REQ resp. wait for the annotated delay before issuing the next response
+                at_evt.notify(t);
+                return;
+            }
+        } else
+            at_resp_in_progress = entry.trans;
+    }
 }
 
 template <unsigned long long SIZE, unsigned BUSWIDTH>
@@ -130,77 +512,122 @@ int memory<SIZE, BUSWIDTH>::handle_operation(tlm::tlm_generic_payload& trans, sc
     uint8_t* ptr = trans.get_data_ptr();
     unsigned len = trans.get_data_length();
     uint8_t* byt = trans.get_byte_enable_ptr();
+    unsigned be_len = trans.get_byte_enable_length();
     unsigned wid = trans.get_streaming_width();
-    // check address range and check for unsupported features,
-    //   i.e. byte enables, streaming, and bursts
-    // Can ignore DMI hint and extensions
-    if(adr + len > ::sc_dt::uint64(SIZE)) {
+    // a streaming width smaller than the data length denotes a FIFO like access where each beat of wid bytes
+    // accesses the same address range
+    if(!wid || wid > len)
+        wid = len;
+    // check address range and byte enables, DMI hint and extensions can be ignored
+    if(adr + wid > ::sc_dt::uint64(SIZE)) {
         SC_REPORT_ERROR("TLM-2", "generic payload transaction exceeeds memory size");
         trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
         return 0;
     }
-    if(wid < len) {
-        SCCERR(SCMOD) << "Streaming width: " << wid << ", data length: " << len;
-        SC_REPORT_ERROR("TLM-2", "generic payload transaction not supported");
-        trans.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
+    if(byt && !be_len) {
+        SC_REPORT_ERROR("TLM-2", "generic payload transaction with byte enable pointer but zero byte enable length");
+        trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
         return 0;
     }
-    if(byt) {
-        auto res = std::accumulate(byt, byt + trans.get_byte_enable_length(), 0xff, [](uint8_t a, uint8_t b) { return a | b; });
-        if(trans.get_byte_enable_length() != len || res != 0xff) {
-            SC_REPORT_ERROR("TLM-2", "generic payload transaction with scattered byte enable not supported");
-            trans.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
-            return 0;
-        }
-    }
     tlm::tlm_command cmd = trans.get_command();
     SCCTRACE(SCMOD) << (cmd == tlm::TLM_READ_COMMAND ? "read" : "write") << " access to addr 0x" << std::hex << adr;
-    if(cmd == tlm::TLM_READ_COMMAND) {
-        delay += clk_i.get_interface() ? clk_i->read() * rd_resp_clk_delay : rd_resp_delay;
-        if(mem.is_allocated(adr)) {
-            const auto& p = mem(adr / mem.page_size);
-            auto offs = adr & mem.page_addr_mask;
-            if((offs + len) > mem.page_size) {
-                auto first_part = mem.page_size - offs;
-                std::copy(p.data() + offs, p.data() + offs + first_part, ptr);
-                const auto& p2 = mem((adr / mem.page_size) + 1);
-                std::copy(p2.data(), p2.data() + len - first_part, ptr + first_part);
-            } else {
-                std::copy(p.data() + offs, p.data() + offs + len, ptr);
-            }
-        } else {
-            // no allocated page so return randomized data
-            for(size_t i = 0; i < len; i++)
-                ptr[i] = scc::MT19937::uniform() % 256;
-        }
-    } else if(cmd == tlm::TLM_WRITE_COMMAND) {
-        delay += clk_i.get_interface() ? clk_i->read() * wr_resp_clk_delay : wr_resp_delay;
-        auto& p = mem(adr / mem.page_size);
-        auto offs = adr & mem.page_addr_mask;
-        if((offs + len) > mem.page_size) {
-            auto first_part = mem.page_size - offs;
-            std::copy(ptr, ptr + first_part, p.data() + offs);
-            auto& p2 = mem((adr / mem.page_size) + 1);
-            std::copy(ptr + first_part, ptr + len, p2.data());
-        } else {
-            std::copy(ptr, ptr + len, p.data() + offs);
+    // pages of a loaded snapshot are decompressed upon their first access which may fail
+    auto ok = access_pages([&]() {
+        if(cmd == tlm::TLM_READ_COMMAND) {
+            delay += rd_delay();
+            for_each_page_segment(adr, len, wid, [this, ptr, byt, be_len](uint64_t addr, unsigned offs, unsigned seg_len) {
+                if(auto* p = mem.get_page(addr / mem.page_size)) {
+                    util::masked_copy(ptr + offs, p->data() + (addr & mem.page_addr_mask), byt, be_len, offs, seg_len);
+                } else {
+                    // no allocated page so return the fill data
+                    if(!byt) {
+                        fill_unallocated(ptr + offs, addr, seg_len);
+                        return;
+                    }
+                    if(fill_policy.get_value() == FILL_MT19937) {
+                        // only enabled bytes draw a number, masked-off bytes neither consume numbers nor change the data
+                        auto rng = scc::MT19937::get_handle();
+                        for(unsigned i = offs; i < offs + seg_len; i++)
+                            if(byt[i % be_len])
+                                ptr[i] = rng.uniform() % 256;
+                        return;
+                    }
+                    uint8_t buf[256];
+                    for(unsigned done = 0; done < seg_len;) {
+                        auto chunk = std::min<unsigned>(sizeof(buf), seg_len - done);
+                        fill_unallocated(buf, addr + done, chunk);
+                        util::masked_copy(ptr + offs + done, buf, byt, be_len, offs + done, chunk);
+                        done += chunk;
+                    }
+                }
+            });
+        } else if(cmd == tlm::TLM_WRITE_COMMAND) {
+            delay += wr_delay();
+            for_each_page_segment(adr, len, wid, [this, ptr, byt, be_len](uint64_t addr, unsigned offs, unsigned seg_len) {
+                auto& p = mem(addr / mem.page_size);
+                util::masked_copy(p.data() + (addr & mem.page_addr_mask), ptr + offs, byt, be_len, offs, seg_len);
+            });
         }
+    });
+    if(!ok) {
+        trans.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
+        return 0;
     }
     trans.set_response_status(tlm::TLM_OK_RESPONSE);
     trans.set_dmi_allowed(true);
     return len;
 }
 
+template <unsigned long long SIZE, unsigned BUSWIDTH>
+template <typename FUNC>
+inline void memory<SIZE, BUSWIDTH>::for_each_page_segment(uint64_t adr, unsigned len, unsigned wid, FUNC f) {
+    for(unsigned beat = 0; beat < len; beat += wid) {
+        auto beat_len = std::min(wid, len - beat);
+        for(unsigned done = 0; done < beat_len;) {
+            auto addr = adr + done;
+            auto seg_len = static_cast<unsigned>(std::min<uint64_t>(mem.page_size - (addr & mem.page_addr_mask), beat_len - done));
+            f(addr, beat + done, seg_len);
+            done += seg_len;
+        }
+    }
+}
+
+template <unsigned long long SIZE, unsigned BUSWIDTH>
+inline void memory<SIZE, BUSWIDTH>::fill_unallocated(uint8_t* ptr, uint64_t addr, size_t len) const {
+    switch(fill_policy.get_value()) {
+    case FILL_ZERO:
+        memset(ptr, 0, len);
+        break;
+    case FILL_PATTERN:
+        util::fill_pattern(ptr, addr, len, fill_pattern.get_value());
+        break;
+    case FILL_ADDR_HASH:
+        util::fill_addr_hash(ptr, addr, len);
+        break;
+    case FILL_MT19937: {
+        auto rng = scc::MT19937::get_handle();
+        for(size_t i = 0; i < len; ++i)
+            ptr[i] = rng.uniform() % 256;
+        break;
+    }
+    default:
+        util::fill_random(ptr, addr, len, fill_seed.get_value());
+        break;
+    }
+}
+
 template <unsigned long long SIZE, unsigned BUSWIDTH>
 inline bool memory<SIZE, BUSWIDTH>::handle_dmi(tlm::tlm_generic_payload& gp, tlm::tlm_dmi& dmi_data) {
-    auto& p = mem(gp.get_address() / mem.page_size);
+    uint8_t* ptr{nullptr};
+    if(!access_pages([this, &gp, &ptr]() { ptr = mem(gp.get_address() / mem.page_size).data(); }))
+        return false;
     dmi_data.set_start_address(gp.get_address() & ~mem.page_addr_mask);
     // TODO: fix to provide the correct end address
     dmi_data.set_end_address(dmi_data.get_start_address() + mem.page_size - 1);
-    dmi_data.set_dmi_ptr(p.data());
+    dmi_data.set_dmi_ptr(ptr);
     dmi_data.set_granted_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
-    dmi_data.set_read_latency(clk_i.get_interface() ? clk_i->read() * rd_resp_clk_delay : rd_resp_delay);
-    dmi_data.set_write_latency(clk_i.get_interface() ? clk_i->read() * wr_resp_clk_delay : wr_resp_delay);
+    dmi_data.set_read_latency(rd_delay());
+    dmi_data.set_write_latency(wr_delay());
     return true;
 }
 
@@ -28,9 +28,13 @@
 #else
 #include "util/delegate.h"
 #endif
+#include <array>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <sstream>
+#include <type_traits>
+#include <typeinfo>
 
 namespace scc {
 
@@ -93,6 +97,13 @@ public:
     , wrmask(wrmask)
     , storage(storage) {
         owner.register_resource(this);
+        if(std::is_integral<DATATYPE>::value && sizeof(DATATYPE) <= sizeof(direct.rdmask)) {
+            direct.storage = reinterpret_cast<uint8_t*>(&storage);
+            direct.size = sizeof(DATATYPE);
+            memcpy(direct.rdmask, &this->rdmask, sizeof(DATATYPE));
+            memcpy(direct.wrmask, &this->wrmask, sizeof(DATATYPE));
+            update_direct_access();
+        }
     }
     /**
      * @fn  ~sc_register()
@@ -114,7 +125,10 @@ public:
      */
     void reset() override {
         DATATYPE r(res_val);
-        if(wr_cb) {
+        if(wr_dlgt) {
+            sc_core::sc_time d;
+            wr_dlgt(*this, r, d);
+        } else if(wr_cb) {
             sc_core::sc_time d;
             wr_cb(*this, r, d);
         }
@@ -136,6 +150,8 @@ public:
         auto temp(storage);
         auto beg = reinterpret_cast<uint8_t*>(&temp) + offset;
         std::copy(data, data + length, beg);
+        if(wr_dlgt)
+            return wr_dlgt(*this, temp, d);
         if(wr_cb)
             return wr_cb(*this, temp, d);
         storage = (temp & wrmask) | (storage & ~wrmask);
@@ -155,7 +171,10 @@ public:
     bool read(uint8_t* data, size_t length, uint64_t offset, sc_core::sc_time& d) const override {
         assert("Access out of range" && offset + length <= sizeof(DATATYPE));
         auto temp(storage);
-        if(rd_cb) {
+        if(rd_dlgt) {
+            if(!rd_dlgt(*this, temp, d))
+                return false;
+        } else if(rd_cb) {
             if(!rd_cb(*this, temp, d))
                 return false;
         } else
@@ -200,6 +219,25 @@ public:
         *reinterpret_cast<DATATYPE*>(data) = storage;
         return true;
     }
+    /**
+     * @fn const resource_direct_access* get_direct_access()const
+     * @brief get the description for direct accesses, reads and writes are direct as long as no callback is set
+     *
+     * @return the description or nullptr if DATATYPE is not an integral type or direct accesses are not allowed
+     */
+    const resource_direct_access* get_direct_access() const override {
+        return direct.storage && allow_direct_access() ? &direct : nullptr;
+    }
+    /**
+     * @fn bool allow_direct_access()const
+     * @brief check if accesses may bypass read() and write()
+     *
+     * Direct accesses are only allowed for sc_register itself as a derived class might override read() or write(). A
+     * derived class keeping the semantics of both can override this function to return true.
+     *
+     * @return true if direct accesses are allowed
+     */
+    virtual bool allow_direct_access() const { return typeid(*this) == typeid(this_type); }
     /**
      * @fn  operator DATATYPE()const
      * @brief cast operator to get underlying storage
@@ -264,6 +302,8 @@ public:
      */
     void set_read_cb(std::function<bool(const this_type&, DATATYPE&)> read_cb) {
         rd_cb = [read_cb](const this_type& reg, DATATYPE& data, sc_core::sc_time& delay) { return read_cb(reg, data); };
+        rd_dlgt = rd_dlgt_type();
+        update_direct_access();
     }
     /**
      * @fn void set_read_cb(std::function<bool (const this_type&, DATATYPE&, sc_core::sc_time)>)
@@ -273,7 +313,11 @@ public:
      *
      * @param read_cb the callback functor
      */
-    void set_read_cb(std::function<bool(const this_type&, DATATYPE&, sc_core::sc_time&)> read_cb) { rd_cb = read_cb; }
+    void set_read_cb(std::function<bool(const this_type&, DATATYPE&, sc_core::sc_time&)> read_cb) {
+        rd_cb = read_cb;
+        rd_dlgt = rd_dlgt_type();
+        update_direct_access();
+    }
     /**
      * @fn void set_write_cb(std::function<bool (this_type&, const DATATYPE&)>)
      * @brief set the write callback
@@ -285,6 +329,8 @@ public:
      */
     void set_write_cb(std::function<bool(this_type&, const DATATYPE&)> write_cb) {
         wr_cb = [write_cb](this_type& reg, DATATYPE& data, sc_core::sc_time& delay) { return write_cb(reg, data); };
+        wr_dlgt = wr_dlgt_type();
+        update_direct_access();
     }
     /**
      * @fn void set_write_cb(std::function<bool (this_type&, const DATATYPE&, sc_core::sc_time)>)
@@ -299,7 +345,71 @@ public:
      *
      * @param write_cb
      */
-    void set_write_cb(std::function<bool(this_type&, const DATATYPE&, sc_core::sc_time&)> write_cb) { wr_cb = write_cb; }
+    void set_write_cb(std::function<bool(this_type&, const DATATYPE&, sc_core::sc_time&)> write_cb) {
+        wr_cb = write_cb;
+        wr_dlgt = wr_dlgt_type();
+        update_direct_access();
+    }
+    /**
+     * @fn void set_read_cb(C*)
+     * @brief set a member function as read callback
+     *
+     * The callback is stored as delegate, calling it costs a single indirect call and setting it does not allocate.
+     * Usage: reg.set_read_cb<my_module, &my_module::read_reg>(this);
+     *
+     * @param obj the object the member function is called on
+     */
+    template <typename C, bool (C::*M)(const this_type&, DATATYPE&, sc_core::sc_time&)> void set_read_cb(C* obj) {
+#ifdef _MSC_VER
+        rd_dlgt = [obj](const this_type& reg, DATATYPE& data, sc_core::sc_time& delay) { return (obj->*M)(reg, data, delay); };
+#else
+        rd_dlgt = rd_dlgt_type::template from<C, M>(obj);
+#endif
+        rd_cb = nullptr;
+        update_direct_access();
+    }
+    /**
+     * @fn void set_read_cb(C*, bool(C::*)(const this_type&, DATATYPE&, sc_core::sc_time&))
+     * @brief set a member function given as runtime pointer as read callback
+     *
+     * @param obj the object the member function is called on
+     * @param method the member function
+     */
+    template <typename C> void set_read_cb(C* obj, bool (C::*method)(const this_type&, DATATYPE&, sc_core::sc_time&)) {
+        rd_dlgt = [obj, method](const this_type& reg, DATATYPE& data, sc_core::sc_time& delay) { return (obj->*method)(reg, data, delay); };
+        rd_cb = nullptr;
+        update_direct_access();
+    }
+    /**
+     * @fn void set_write_cb(C*)
+     * @brief set a member function as write callback
+     *
+     * The callback is stored as delegate, calling it costs a single indirect call and setting it does not allocate.
+     * Usage: reg.set_write_cb<my_module, &my_module::write_reg>(this);
+     *
+     * @param obj the object the member function is called on
+     */
+    template <typename C, bool (C::*M)(this_type&, const DATATYPE&, sc_core::sc_time&)> void set_write_cb(C* obj) {
+#ifdef _MSC_VER
+        wr_dlgt = [obj](this_type& reg, const DATATYPE& data, sc_core::sc_time& delay) { return (obj->*M)(reg, data, delay); };
+#else
+        wr_dlgt = wr_dlgt_type::template from<C, M>(obj);
+#endif
+        wr_cb = nullptr;
+        update_direct_access();
+    }
+    /**
+     * @fn void set_write_cb(C*, bool(C::*)(this_type&, const DATATYPE&, sc_core::sc_time&))
+     * @brief set a member function given as runtime pointer as write callback
+     *
+     * @param obj the object the member function is called on
+     * @param method the member function
+     */
+    template <typename C> void set_write_cb(C* obj, bool (C::*method)(this_type&, const DATATYPE&, sc_core::sc_time&)) {
+        wr_dlgt = [obj, method](this_type& reg, const DATATYPE& data, sc_core::sc_time& delay) { return (obj->*method)(reg, data, delay); };
+        wr_cb = nullptr;
+        update_direct_access();
+    }
     /**
      * @fn void trace(sc_core::sc_trace_file*)const
      * @brief trace the register value to the given trace file
@@ -317,17 +427,25 @@ public:
 private:
     const char* kind() const override { return "sc_register"; }
 
+    void update_direct_access() {
+        direct.read_direct = direct.storage && !rd_cb && !rd_dlgt;
+        direct.write_direct = direct.storage && !wr_cb && !wr_dlgt;
+    }
+
     DATATYPE& storage;
+    resource_direct_access direct;
     std::function<bool(const this_type&, DATATYPE&, sc_core::sc_time&)> rd_cb;
     std::function<bool(this_type&, DATATYPE&, sc_core::sc_time&)> wr_cb;
 
 #ifdef _MSC_VER
-    std::function<bool(const this_type&, DATATYPE&, sc_core::sc_time&)> rd_dlgt;
-    std::function<bool(this_type&, DATATYPE&, sc_core::sc_time&)> wr_dlgt;
+    using rd_dlgt_type = std::function<bool(const this_type&, DATATYPE&, sc_core::sc_time&)>;
+    using wr_dlgt_type = std::function<bool(this_type&, const DATATYPE&, sc_core::sc_time&)>;
 #else
-    util::delegate<bool(const this_type&, DATATYPE&, sc_core::sc_time&)> rd_dlgt;
-    util::delegate<bool(this_type&, DATATYPE&, sc_core::sc_time&)> wr_dlgt;
+    using rd_dlgt_type = util::delegate<bool(const this_type&, DATATYPE&, sc_core::sc_time&)>;
+    using wr_dlgt_type = util::delegate<bool(this_type&, const DATATYPE&, sc_core::sc_time&)>;
 #endif
+    rd_dlgt_type rd_dlgt;
+    wr_dlgt_type wr_dlgt;
 };
 } // namespace impl
 //! import the implementation into the scc namespace
@@ -379,8 +497,8 @@ public:
      */
     void set_read_cb(std::function<bool(size_t, const sc_register<DATATYPE>&, DATATYPE&)> read_cb) {
         rd_cb = read_cb;
-        for(size_t idx = START; idx < SIZE + START; ++idx)
-            _reg_field[idx].set_read_cb([this, idx](const sc_register<DATATYPE>& reg, DATATYPE& dt) { return this->rd_cb(idx, reg, dt); });
+        rd_time_cb = nullptr;
+        install_read_cb();
     }
     /**
      * set the read callback triggered upon a read request
@@ -389,10 +507,8 @@ public:
      */
     void set_read_cb(std::function<bool(size_t, const sc_register<DATATYPE>&, DATATYPE&, sc_core::sc_time&)> read_cb) {
         rd_time_cb = read_cb;
-        for(size_t idx = START; idx < SIZE + START; ++idx)
-            _reg_field[idx].set_read_cb([this, idx](const sc_register<DATATYPE>& reg, DATATYPE& dt, sc_core::sc_time& delay) {
-                return this->rd_time_cb(idx, reg, dt, delay);
-            });
+        rd_cb = nullptr;
+        install_read_cb();
     }
     /**
      * set the write callback triggered upon a write request without forwarding the annotated time
@@ -402,8 +518,8 @@ public:
      */
     void set_write_cb(std::function<bool(size_t, sc_register<DATATYPE>&, DATATYPE const&)> write_cb) {
         wr_cb = write_cb;
-        for(size_t idx = START; idx < SIZE + START; ++idx)
-            _reg_field[idx].set_write_cb([this, idx](sc_register<DATATYPE>& reg, const DATATYPE& dt) { return this->wr_cb(idx, reg, dt); });
+        wr_time_cb = nullptr;
+        install_write_cb();
     }
     /**
      * set the write callback triggered upon a write request
@@ -412,10 +528,8 @@ public:
      */
     void set_write_cb(std::function<bool(size_t, sc_register<DATATYPE>&, DATATYPE const&, sc_core::sc_time&)> write_cb) {
         wr_time_cb = write_cb;
-        for(size_t idx = START; idx < SIZE + START; ++idx)
-            _reg_field[idx].set_write_cb([this, idx](sc_register<DATATYPE>& reg, const DATATYPE& dt, sc_core::sc_time& delay) {
-                return this->wr_time_cb(idx, reg, dt, delay);
-            });
+        wr_cb = nullptr;
+        install_write_cb();
     }
     /**
      * Element access operator
@@ -453,11 +567,41 @@ public:
     }
 
 private:
+    /*
+     * the callbacks are stored once in the register file, each register refers to it by a delegate to its element
+     * context which just adds the index
+     */
+    struct element_cb {
+        sc_register_indexed* parent;
+        size_t idx;
+        bool read(const value_type& reg, DATATYPE& dt, sc_core::sc_time& delay) {
+            return parent->rd_time_cb ? parent->rd_time_cb(idx, reg, dt, delay) : parent->rd_cb(idx, reg, dt);
+        }
+        bool write(value_type& reg, const DATATYPE& dt, sc_core::sc_time& delay) {
+            return parent->wr_time_cb ? parent->wr_time_cb(idx, reg, dt, delay) : parent->wr_cb(idx, reg, dt);
+        }
+    };
+
+    void install_read_cb() {
+        for(size_t idx = START; idx < SIZE + START; ++idx) {
+            element_cbs[idx] = element_cb{this, idx};
+            _reg_field[idx].template set_read_cb<element_cb, &element_cb::read>(&element_cbs[idx]);
+        }
+    }
+
+    void install_write_cb() {
+        for(size_t idx = START; idx < SIZE + START; ++idx) {
+            element_cbs[idx] = element_cb{this, idx};
+            _reg_field[idx].template set_write_cb<element_cb, &element_cb::write>(&element_cbs[idx]);
+        }
+    }
+
     sc_core::sc_vector<value_type> _reg_field;
+    std::array<element_cb, START + SIZE> element_cbs;
     std::function<bool(size_t, sc_register<DATATYPE>&, DATATYPE const&)> wr_cb;
     std::function<bool(size_t, sc_register<DATATYPE>&, DATATYPE const&, sc_core::sc_time&)> wr_time_cb;
-    std::function<bool(size_t, sc_register<DATATYPE> const&, DATATYPE const&)> rd_cb;
-    std::function<bool(size_t, sc_register<DATATYPE> const&, DATATYPE const&, sc_core::sc_time&)> rd_time_cb;
+    std::function<bool(size_t, sc_register<DATATYPE> const&, DATATYPE&)> rd_cb;
+    std::function<bool(size_t, sc_register<DATATYPE> const&, DATATYPE&, sc_core::sc_time&)> rd_time_cb;
 };
 /**
  * alias class to map template argument read an write mask to constructor arguments
@@ -22,6 +22,56 @@
 #include <sysc/kernel/sc_time.h>
 
 namespace scc {
+/**
+ * @struct resource_direct_access
+ * @brief describes a resource which can be accessed by plain masked loads and stores
+ *
+ * A resource provides this description if its accesses have no side effects (e.g. a register without callbacks).
+ * The flags are maintained by the resource and need to be checked upon each access. Masks are given in the byte
+ * order of the storage.
+ */
+struct resource_direct_access {
+    //! the storage of the resource
+    uint8_t* storage{nullptr};
+    //! the size of the resource in bytes
+    unsigned size{0};
+    //! the read mask, one byte per byte of storage
+    uint8_t rdmask[8]{};
+    //! the write mask, one byte per byte of storage
+    uint8_t wrmask[8]{};
+    //! true if a read can be executed as masked load
+    bool read_direct{false};
+    //! true if a write can be executed as masked store
+    bool write_direct{false};
+    /**
+     * @fn bool read(uint8_t*, std::size_t, uint64_t)const
+     * @brief executes a masked load if possible
+     *
+     * @return true if the access has been executed
+     */
+    inline bool read(uint8_t* data, std::size_t length, uint64_t offset) const {
+        if(!read_direct || offset + length > size)
+            return false;
+        for(std::size_t i = 0; i < length; ++i)
+            data[i] = storage[offset + i] & rdmask[offset + i];
+        return true;
+    }
+    /**
+     * @fn bool write(const uint8_t*, std::size_t, uint64_t)const
+     * @brief executes a masked store if possible
+     *
+     * @return true if the access has been executed
+     */
+    inline bool write(const uint8_t* data, std::size_t length, uint64_t offset) const {
+        if(!write_direct || offset + length > size)
+            return false;
+        for(std::size_t i = 0; i < length; ++i) {
+            auto& s = storage[offset + i];
+            s = (data[i] & wrmask[offset + i]) | (s & ~wrmask[offset + i]);
+        }
+        return true;
+    }
+};
 /**
  * @class resource_access_if
  * @brief interface defining access to a resource e.g. a register
@@ -94,6 +144,13 @@ public:
      * @return true it the access is successful
      */
     virtual bool read_dbg(uint8_t* data, std::size_t length, uint64_t offset = 0) const = 0;
+    /**
+     * @fn const resource_direct_access* get_direct_access()const
+     * @brief get the description for direct accesses bypassing read() and write()
+     *
+     * @return the description or nullptr if the resource does not support direct accesses
+     */
+    virtual const resource_direct_access* get_direct_access() const { return nullptr; }
 };
 /**
  * @class indexed_resource_access_if
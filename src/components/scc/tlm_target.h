@@ -19,11 +19,14 @@
 
 #include "resource_access_if.h"
 #include <array>
+#include <cstring>
+#include <limits>
 #include <numeric>
 #include <scc/utilities.h>
 #include <tlm/scc/scv/tlm_rec_target_socket.h>
 #include <tlm/scc/target_mixin.h>
 #include <util/range_lut.h>
+#include <vector>
 
 namespace scc {
 /**
@@ -34,6 +37,53 @@ namespace scc {
 struct addr_range {
     uint64_t base, size;
 };
+/**
+ * @class byte_enable_classifier
+ * @brief determines the ranges of enabled bytes of a byte enable mask
+ *
+ * The mask is scanned 8 bytes at a time testing for all disabled or all enabled words, only mixed words are
+ * inspected byte by byte. The result vector is reused so a classification does not allocate memory.
+ */
+class byte_enable_classifier {
+public:
+    //! a range of enabled bytes given as start and length
+    using run_type = std::pair<unsigned, unsigned>;
+    /**
+     * @fn const std::vector<run_type>& classify(const uint8_t*, unsigned)
+     * @brief get the ranges of enabled bytes of a mask, a byte is enabled if it is non-zero
+     *
+     * @param be the byte enable mask
+     * @param len the length of the mask
+     * @return the ranges of enabled bytes in ascending order, valid until the next call
+     */
+    std::vector<run_type> const& classify(uint8_t const* be, unsigned len) {
+        runs.clear();
+        auto add = [this](unsigned pos, unsigned cnt) {
+            if(runs.size() && runs.back().first + runs.back().second == pos)
+                runs.back().second += cnt;
+            else
+                runs.emplace_back(pos, cnt);
+        };
+        unsigned i = 0;
+        for(; i + 8 <= len; i += 8) {
+            uint64_t w;
+            memcpy(&w, be + i, 8);
+            if(w == std::numeric_limits<uint64_t>::max())
+                add(i, 8);
+            else if(w)
+                for(auto j = i; j < i + 8; ++j)
+                    if(be[j])
+                        add(j, 1);
+        }
+        for(; i < len; ++i)
+            if(be[i])
+                add(i, 1);
+        return runs;
+    }
+
+private:
+    std::vector<run_type> runs;
+};
 /**
  * @class tlm_target
  * @brief a simple access-width based bus interface (no DMI support)
@@ -79,6 +129,7 @@ public:
      */
     void addResource(resource_access_if& rai, uint64_t base_addr) {
         socket_map.addEntry(std::make_pair(&rai, base_addr), base_addr, std::max<size_t>(1, rai.size() / (ADDR_UNIT_WIDTH / 8)));
+        dispatch_valid = false;
     }
     /**
      * @fn void addResource(indexed_resource_access_if&, uint64_t)
@@ -92,10 +143,56 @@ public:
             socket_map.addEntry(std::make_pair(&irai[idx], base_addr), base_addr, irai_size);
             base_addr += irai_size;
         }
+        dispatch_valid = false;
     }
+    /**
+     * @fn void build_dispatch_table()
+     * @brief build the table used to resolve accesses
+     *
+     * If the resources occupy a dense address window a flat table indexed by (addr-base)/stride is used, otherwise
+     * the accesses are resolved using the range based lookup table. The table is built upon the first access after
+     * resources have been added, it can be built upfront (e.g. in end_of_elaboration) by calling this function.
+     */
+    void build_dispatch_table();
+
+    /**
+     * @fn void set_split_byte_enables(bool)
+     * @brief allow byte enables with several enabled ranges
+     *
+     * If enabled an access with a non-contiguous byte enable mask is forwarded to the resource as several accesses,
+     * one per contiguous range of enabled bytes. Otherwise such an access gets a TLM_BYTE_ENABLE_ERROR_RESPONSE.
+     *
+     * @param enable the new setting
+     */
+    void set_split_byte_enables(bool enable) { split_byte_enables = enable; }
 
 private:
+    struct dispatch_entry {
+        resource_access_if* ra;
+        uint64_t base;
+        const resource_direct_access* direct;
+    };
+    inline dispatch_entry lookup(uint64_t addr) {
+        if(!dispatch_valid)
+            build_dispatch_table();
+        if(dense_table.size()) {
+            auto idx = (addr - dense_base) / dense_stride;
+            return addr >= dense_base && idx < dense_table.size() ? dense_table[idx] : dispatch_entry{nullptr, 0, nullptr};
+        }
+        resource_access_if* ra = nullptr;
+        uint64_t base = 0;
+        std::tie(ra, base) = socket_map.getEntry(addr);
+        return dispatch_entry{ra, base, ra ? ra->get_direct_access() : nullptr};
+    }
+    bool access(dispatch_entry const& e, tlm::tlm_generic_payload& gp, uint64_t offset, unsigned start, unsigned len,
+                sc_core::sc_time& delay);
     sc_core::sc_time& clk;
+    byte_enable_classifier be_classifier;
+    bool split_byte_enables{false};
+    bool dispatch_valid{false};
+    std::vector<dispatch_entry> dense_table;
+    uint64_t dense_base{0};
+    uint64_t dense_stride{1};
 
 protected:
     util::range_lut<std::pair<resource_access_if*, uint64_t>> socket_map;
@@ -136,64 +233,28 @@ inline scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::tlm_target(sc_core::sc_time&
 
 template <unsigned int BUSWIDTH, unsigned int ADDR_UNIT_WIDTH>
 void scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::b_tranport_cb(tlm::tlm_generic_payload& gp, sc_core::sc_time& delay) {
-    resource_access_if* ra = nullptr;
-    uint64_t base = 0;
-    std::tie(ra, base) = socket_map.getEntry(gp.get_address());
+    auto entry = lookup(gp.get_address());
+    auto* ra = entry.ra;
     if(ra) {
-        auto offset = 0;
-        auto len = gp.get_data_length();
-        auto contigous = true;
-        if(gp.get_byte_enable_ptr()) {
-            auto lower = std::numeric_limits<unsigned>::max();
-            auto upper = std::numeric_limits<unsigned>::max();
-            auto en = false;
-            auto p = gp.get_byte_enable_ptr();
-            auto i = 0u;
-            for(; i < gp.get_byte_enable_length(); ++i, ++p) {
-                if(*p && !en) {
-                    if(lower != std::numeric_limits<unsigned>::max()) {
-                        contigous = false;
-                        break;
-                    } else {
-                        lower = i;
-                        en = true;
-                    }
-                }
-                if(!*p && en) {
-                    if(upper != std::numeric_limits<unsigned>::max()) {
-                        contigous = false;
-                        break;
-                    } else {
-                        upper = i;
-                        en = false;
-                    }
-                }
-            }
-            if(i == gp.get_byte_enable_length() && upper == std::numeric_limits<unsigned>::max())
-                upper = i;
-            if(contigous) {
-                offset = lower;
-                len = upper - lower;
-            }
-        }
+        auto be = gp.get_byte_enable_ptr();
+        auto const* runs = be ? &be_classifier.classify(be, gp.get_byte_enable_length()) : nullptr;
         if(gp.get_data_length() > ra->size()) {
             gp.set_response_status(tlm::TLM_BURST_ERROR_RESPONSE);
         } else if(gp.get_data_length() != gp.get_streaming_width()) {
             gp.set_response_status(tlm::TLM_GENERIC_ERROR_RESPONSE);
-        } else if(gp.get_byte_enable_ptr() != nullptr && !(contigous && gp.get_byte_enable_length() == gp.get_data_length())) {
+        } else if(runs && (gp.get_byte_enable_length() != gp.get_data_length() || (runs->size() > 1 && !split_byte_enables))) {
             gp.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
-        } else {
+        } else if(gp.get_command() != tlm::TLM_READ_COMMAND && gp.get_command() != tlm::TLM_WRITE_COMMAND) {
             gp.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
-            switch(gp.get_command()) {
-            case tlm::TLM_READ_COMMAND:
-                if(ra->read(gp.get_data_ptr() + offset, len, (gp.get_address() - base + offset), delay))
-                    gp.set_response_status(tlm::TLM_OK_RESPONSE);
-                break;
-            case tlm::TLM_WRITE_COMMAND:
-                if(ra->write(gp.get_data_ptr() + offset, len, (gp.get_address() - base + offset), delay))
-                    gp.set_response_status(tlm::TLM_OK_RESPONSE);
-                break;
-            }
+        } else {
+            auto offset = gp.get_address() - entry.base;
+            auto success = true;
+            if(!runs)
+                success = access(entry, gp, offset, 0, gp.get_data_length(), delay);
+            else
+                for(auto const& r : *runs)
+                    success &= access(entry, gp, offset, r.first, r.second, delay);
+            gp.set_response_status(success ? tlm::TLM_OK_RESPONSE : tlm::TLM_COMMAND_ERROR_RESPONSE);
         }
     } else {
         gp.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
@@ -201,6 +262,70 @@ void scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::b_tranport_cb(tlm::tlm_generic_
     delay += clk;
 }
 
+template <unsigned int BUSWIDTH, unsigned int ADDR_UNIT_WIDTH>
+inline bool scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::access(dispatch_entry const& e, tlm::tlm_generic_payload& gp, uint64_t offset,
+                                                              unsigned start, unsigned len, sc_core::sc_time& delay) {
+    // resources without side effects are accessed by masked loads and stores bypassing the virtual functions
+    if(gp.get_command() == tlm::TLM_READ_COMMAND)
+        return (e.direct && e.direct->read(gp.get_data_ptr() + start, len, offset + start)) ||
+               e.ra->read(gp.get_data_ptr() + start, len, offset + start, delay);
+    return (e.direct && e.direct->write(gp.get_data_ptr() + start, len, offset + start)) ||
+           e.ra->write(gp.get_data_ptr() + start, len, offset + start, delay);
+}
+
+template <unsigned int BUSWIDTH, unsigned int ADDR_UNIT_WIDTH> void scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::build_dispatch_table() {
+    dispatch_valid = true;
+    dense_table.clear();
+    struct range {
+        uint64_t base, size;
+        std::pair<resource_access_if*, uint64_t> entry;
+    };
+    std::vector<range> ranges;
+    uint64_t begin = 0;
+    for(auto const& e : socket_map) {
+        if(e.second.index.first == nullptr)
+            continue;
+        switch(e.second.type) {
+        case util::range_lut<std::pair<resource_access_if*, uint64_t>>::BEGIN_RANGE:
+            begin = e.first;
+            break;
+        case util::range_lut<std::pair<resource_access_if*, uint64_t>>::END_RANGE:
+            ranges.push_back(range{begin, e.first - begin + 1, e.second.index});
+            break;
+        default:
+            ranges.push_back(range{e.first, 1, e.second.index});
+            break;
+        }
+    }
+    if(ranges.empty())
+        return;
+    // the stride is the largest granule all resources are aligned to, so each slot belongs to at most one resource
+    auto gcd = [](uint64_t a, uint64_t b) {
+        while(b) {
+            auto t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    };
+    auto base = ranges.front().base;
+    uint64_t stride = 0;
+    for(auto const& r : ranges)
+        stride = gcd(gcd(stride, r.size), r.base - base);
+    auto slots = (ranges.back().base + ranges.back().size - base) / stride;
+    // only use the table for dense windows, sparse ones are resolved by the range based lookup table
+    if(slots > std::max<uint64_t>(256, 4 * ranges.size()))
+        return;
+    dense_base = base;
+    dense_stride = stride;
+    dense_table.assign(slots, dispatch_entry{nullptr, 0, nullptr});
+    for(auto const& r : ranges) {
+        dispatch_entry e{r.entry.first, r.entry.second, r.entry.first->get_direct_access()};
+        auto first = (r.base - base) / stride;
+        std::fill(dense_table.begin() + first, dense_table.begin() + first + r.size / stride, e);
+    }
+}
+
 template <unsigned int BUSWIDTH, unsigned int ADDR_UNIT_WIDTH>
 unsigned int scc::tlm_target<BUSWIDTH, ADDR_UNIT_WIDTH>::tranport_dbg_cb(tlm::tlm_generic_payload& gp) {
     resource_access_if* ra = nullptr;
@@ -26,8 +26,12 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/preprocessor/arithmetic/add.hpp>
@@ -65,6 +69,15 @@ public:
     virtual void write(datatype_t& valueToWrite) = 0;
     virtual datatype_t read() = 0;
     virtual ~abstract_bitfield() = default;
+    /**
+     * @return true if accesses to the bitfield need to be dispatched to write() and read(), false if the bitfield
+     *         just holds the bits of the register
+     */
+    virtual bool hasCallback() const noexcept { return true; }
+    /**
+     * @return true if writes to the bitfield are ignored
+     */
+    virtual bool isReadOnly() const noexcept { return false; }
 
     constexpr bool affected(size_t byteOffset, size_t byteLength) const noexcept {
         return (byteOffset * 8 < bitOffset + bitSize) && (bitOffset < (byteOffset + byteLength) * 8);
@@ -102,7 +115,9 @@ public:
     , offset{offset}
     , resetValue{resetValue}
     , writeMask{writeMask}
-    , readMask{readMask} {}
+    , readMask{readMask} {
+        updateDispatch();
+    }
 
     /**
      * @return The size of the register in bytes
@@ -115,7 +130,8 @@ public:
         assert("Access out of range" && offset + length <= this->size());
         auto valueToWrite{storage};
         std::copy(data, data + length, reinterpret_cast<uint8_t*>(&valueToWrite) + offset);
-        for(auto&& bitfield : bitfields) {
+        // bitfields without callback are handled by the precomputed masks, only the others are visited
+        for(auto&& bitfield : activeBitfields) {
             if(bitfield.get().affected(offset, length)) {
                 auto mask = bitfield.get().mask();
                 auto bits = (valueToWrite & mask) >> bitfield.get().bitOffset;
@@ -123,17 +139,20 @@ public:
                 valueToWrite = (valueToWrite & ~mask) | ((bits << bitfield.get().bitOffset) & mask);
             }
         }
-        if(writeCallback)
+        if(writeCallback) {
+            // the callback sees the stored bits of read-only bitfields and may change them as before
+            valueToWrite = (valueToWrite & ~readOnlyMask) | (storage & readOnlyMask);
             writeCallback(*this, valueToWrite);
-        storage = (valueToWrite & writeMask) | (storage & ~writeMask);
+        }
+        storage = (valueToWrite & effectiveWriteMask) | (storage & ~effectiveWriteMask);
         return true;
     }
 
     bool read(uint8_t* data, std::size_t length, uint64_t offset, sc_core::sc_time& d) const override {
         assert("Access out of range" && offset + length <= this->size());
         auto result{storage};
-        result &= readMask;
-        for(auto&& bitfield : bitfields) {
+        result &= effectiveReadMask;
+        for(auto&& bitfield : activeBitfields) {
             if(bitfield.get().affected(offset, length)) {
                 auto bitfieldValue = bitfield.get().read();
                 auto mask = bitfield.get().mask();
@@ -173,7 +192,52 @@ public:
      */
     void put(datatype_t value) { storage = value; }
 
-    void registerBitfield(abstract_bitfield<datatype_t>& bitfield) { bitfields.push_back(bitfield); }
+    void registerBitfield(abstract_bitfield<datatype_t>& bitfield) {
+        bitfields.push_back(bitfield);
+        updateDispatch();
+    }
+    /**
+     * Recalculates the masks used to access the bitfields without callbacks. This is called automatically if
+     * bitfields or callbacks are added or the access of a bitfield is changed.
+     */
+    void updateDispatch() {
+        activeBitfields.clear();
+        datatype_t passiveMask{0};
+        readOnlyMask = 0;
+        for(auto&& bitfield : bitfields) {
+            if(bitfield.get().hasCallback())
+                activeBitfields.push_back(bitfield);
+            else {
+                // a plain bitfield reads the stored bits regardless of the read mask
+                passiveMask |= bitfield.get().mask();
+                if(bitfield.get().isReadOnly())
+                    readOnlyMask |= bitfield.get().mask();
+            }
+        }
+        effectiveReadMask = readMask | passiveMask;
+        // with a write callback the read-only bits are restored before calling it so that it can still change them
+        effectiveWriteMask = writeCallback ? writeMask : writeMask & ~readOnlyMask;
+        if(std::is_integral<datatype_t>::value && sizeof(datatype_t) <= sizeof(direct.rdmask)) {
+            direct.storage = reinterpret_cast<uint8_t*>(&storage);
+            direct.size = sizeof(datatype_t);
+            memcpy(direct.rdmask, &effectiveReadMask, sizeof(datatype_t));
+            memcpy(direct.wrmask, &effectiveWriteMask, sizeof(datatype_t));
+            direct.read_direct = activeBitfields.empty() && !readCallback;
+            direct.write_direct = activeBitfields.empty() && !writeCallback;
+        }
+    }
+    /**
+     * @return the description for direct accesses, these are possible as long as neither the register nor one of
+     *         its bitfields has a callback
+     */
+    const resource_direct_access* get_direct_access() const override {
+        return direct.storage && allow_direct_access() ? &direct : nullptr;
+    }
+    /**
+     * Direct accesses bypass read() and write(), hence they are only allowed for bitfield_register itself. A derived
+     * class keeping the semantics of both can override this function to return true.
+     */
+    virtual bool allow_direct_access() const { return typeid(*this) == typeid(bitfield_register<datatype_t>); }
 
     /**
      * Convenience function to access the stored data
@@ -200,6 +264,7 @@ public:
      */
     void setWriteCallback(std::function<void(bitfield_register<datatype_t>&, datatype_t& valueToWrite)> callback) {
         writeCallback = std::move(callback);
+        updateDispatch();
     }
     /**
      * Register a \p callback that gets called on read. Overwrites previously
@@ -210,6 +275,7 @@ public:
      */
     void setReadCallback(std::function<void(const bitfield_register<datatype_t>&, datatype_t& result)> callback) {
         readCallback = std::move(callback);
+        updateDispatch();
     }
 
     const size_t offset;
@@ -223,6 +289,11 @@ protected:
     std::function<void(bitfield_register<datatype_t>&, datatype_t&)> writeCallback;
     std::function<void(const bitfield_register<datatype_t>&, datatype_t&)> readCallback;
     std::vector<std::reference_wrapper<abstract_bitfield<datatype_t>>> bitfields;
+    std::vector<std::reference_wrapper<abstract_bitfield<datatype_t>>> activeBitfields;
+    datatype_t effectiveReadMask{readMask};
+    datatype_t effectiveWriteMask{writeMask};
+    datatype_t readOnlyMask{0};
+    resource_direct_access direct;
 };
 
 template <typename datatype_t> class bitfield : public abstract_bitfield<datatype_t> {
@@ -244,7 +315,7 @@ public:
     bitfield(bitfield_register<datatype_t>& reg, std::string name, size_t bitOffset, size_t bitSize, std::string urid, Access access = RW)
     : reg{reg}
     , abstract_bitfield<datatype_t>{std::move(name), bitOffset, bitSize, std::move(urid)}
-    , access{access} {
+    , access_mode{access} {
         reg.registerBitfield(*this);
     }
     bitfield(const bitfield&) = delete;
@@ -253,7 +324,7 @@ public:
     void write(datatype_t& valueToWrite) override {
         if(writeCallback)
             writeCallback(*this, valueToWrite);
-        if(access == ReadOnly)
+        if(access_mode == ReadOnly)
             valueToWrite = get();
     }
     datatype_t read() override {
@@ -297,6 +368,7 @@ public:
      */
     void setWriteCallback(std::function<void(bitfield<datatype_t>&, datatype_t& valueToWrite)> callback) {
         writeCallback = std::move(callback);
+        reg.updateDispatch();
     }
     /**
      * Register a \p callback that gets called on read. Overwrites previously
@@ -305,10 +377,35 @@ public:
      *
      * Callback is called before the register.
      */
-    void setReadCallback(std::function<datatype_t(const bitfield<datatype_t>&)> callback) { readCallback = std::move(callback); }
+    void setReadCallback(std::function<datatype_t(const bitfield<datatype_t>&)> callback) {
+        readCallback = std::move(callback);
+        reg.updateDispatch();
+    }
+
+    bool hasCallback() const noexcept override { return readCallback || writeCallback; }
+
+    bool isReadOnly() const noexcept override { return access_mode == ReadOnly; }
+    /**
+     * @return the access of this bitfield
+     */
+    Access getAccess() const noexcept { return access_mode; }
+    /**
+     * Changes the access of this bitfield to \p newAccess and updates the dispatch of the containing register
+     */
+    void setAccess(Access newAccess) {
+        access_mode = newAccess;
+        reg.updateDispatch();
+    }
 
     bitfield_register<datatype_t>& reg;
-    Access access;
+    /**
+     * the access of this bitfield, it is read-only as a change needs to update the dispatch of the containing register.
+     * Use setAccess() to change it.
+     */
+    Access const& access{access_mode};
+
+private:
+    Access access_mode;
 
 protected:
     std::function<void(bitfield<datatype_t>&, datatype_t&)> writeCallback;
@@ -341,12 +438,15 @@ public:
      * If no matching register is found a FATALERROR is generated.
      */
     bitfield_register<uint32_t>& getRegister(const std::string& name) {
-        auto found = std::find_if(asDerived().registers.begin(), asDerived().registers.end(),
-                                  [name](const bitfield_register<uint32_t>& reg) { return name.compare(reg.basename()) == 0; });
-        if(found == asDerived().registers.end()) {
+        // the index is built upon the first lookup, the registers are complete once the bitfields get constructed
+        if(registerIndex.empty())
+            for(auto& reg : asDerived().registers)
+                registerIndex.emplace(reg.basename(), &reg);
+        auto found = registerIndex.find(name);
+        if(found == registerIndex.end()) {
             SC_REPORT_FATAL(ID_SCC_TLM_TARGET_BFS_REGISTER_BASE, ("Register " + name + " not found").c_str());
         }
-        return *found;
+        return *found->second;
     }
 
     /**
@@ -357,14 +457,12 @@ public:
      * If no matching bitfield is found a FATALERROR is generated.
      */
     bitfield<uint32_t>& getBitfieldByName(const std::string& regname, const std::string& name) {
-        auto found =
-            std::find_if(asDerived().bitfields.begin(), asDerived().bitfields.end(), [regname, name](const bitfield<uint32_t>& bf) {
-                return regname.compare(bf.reg.basename()) == 0 && name == bf.name;
-            });
-        if(found == asDerived().bitfields.end()) {
+        buildBitfieldIndices();
+        auto found = bitfieldNameIndex.find(regname + '.' + name);
+        if(found == bitfieldNameIndex.end()) {
             SC_REPORT_FATAL(ID_SCC_TLM_TARGET_BFS_REGISTER_BASE, ("Bitfield " + name + " in register " + regname + " not found").c_str());
         }
-        return *found;
+        return *found->second;
     }
 
     /**
@@ -374,12 +472,12 @@ public:
      * @see getBitfield()
      */
     bitfield<uint32_t>& getBitfieldById(const std::string& urid) {
-        auto found = std::find_if(asDerived().bitfields.begin(), asDerived().bitfields.end(),
-                                  [urid](const bitfield<uint32_t>& bf) { return urid == bf.urid; });
-        if(found == asDerived().bitfields.end()) {
+        buildBitfieldIndices();
+        auto found = bitfieldIdIndex.find(urid);
+        if(found == bitfieldIdIndex.end()) {
             SC_REPORT_FATAL(ID_SCC_TLM_TARGET_BFS_REGISTER_BASE, ("Bitfield with urid " + urid + " not found").c_str());
         }
-        return *found;
+        return *found->second;
     }
 
     /**
@@ -407,6 +505,20 @@ public:
 
 private:
     derived_t& asDerived() { return static_cast<derived_t&>(*this); }
+
+    void buildBitfieldIndices() {
+        if(bitfieldIdIndex.size())
+            return;
+        // the first match wins as with a linear search
+        for(auto& bf : asDerived().bitfields) {
+            bitfieldNameIndex.emplace(std::string(bf.reg.basename()) + '.' + bf.name, &bf);
+            bitfieldIdIndex.emplace(bf.urid, &bf);
+        }
+    }
+
+    std::unordered_map<std::string, bitfield_register<uint32_t>*> registerIndex;
+    std::unordered_map<std::string, bitfield<uint32_t>*> bitfieldNameIndex;
+    std::unordered_map<std::string, bitfield<uint32_t>*> bitfieldIdIndex;
 };
 
 } // namespace scc
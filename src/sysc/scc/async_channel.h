@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_ASYNC_CHANNEL_H_
+#define _SCC_ASYNC_CHANNEL_H_
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <systemc>
+#include <util/mpsc_queue.h>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @class async_channel
+ * @brief a channel to inject work from other OS threads into the simulation
+ *
+ * Producers running in arbitrary threads post functions which are executed in the context of the simulation. The
+ * functions are passed through a lock-free queue and the kernel is woken using async_request_update(), hence there is
+ * neither polling nor a timeout involved. All functions having arrived are executed in a single delta cycle by one
+ * method process. Functions posted with a time stamp are executed once the simulation time reaches the time stamp.
+ *
+ * This replaces util::thread_syncronizer for the case where the simulation is the consumer.
+ */
+class async_channel : public sc_core::sc_prim_channel {
+public:
+    /**
+     * @brief the constructor
+     *
+     * @param nm the name of the channel
+     */
+    explicit async_channel(const char* nm = sc_core::sc_gen_unique_name("async_channel"))
+    : sc_core::sc_prim_channel(nm) {
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&wakeup);
+        sc_core::sc_spawn([this]() { dispatch(); }, sc_core::sc_gen_unique_name("dispatch"), &opts);
+    }
+    /**
+     * @brief posts a function to be executed in the next delta cycle, can be called from any thread
+     *
+     * @param f the function
+     */
+    void post(std::function<void()> f) { push({false, sc_core::SC_ZERO_TIME, std::move(f)}); }
+    /**
+     * @brief posts a function to be executed at the given simulation time, can be called from any thread. If the time
+     * has already passed the function is executed in the next delta cycle.
+     *
+     * @param time the absolute simulation time
+     * @param f the function
+     */
+    void post_at(sc_core::sc_time const& time, std::function<void()> f) { push({true, time, std::move(f)}); }
+    /**
+     * @brief keeps the simulation from finishing due to event starvation while waiting for posts
+     *
+     * @param enable if true the simulation waits for posted functions instead of ending
+     * @return true if the setting could be applied (requires SystemC 2.3.2 or later)
+     */
+    bool set_keep_alive(bool enable) {
+#if defined(SYSTEMC_VERSION) && SYSTEMC_VERSION >= 20171012
+        return enable ? async_attach_suspending() : async_detach_suspending();
+#else
+        return false;
+#endif
+    }
+    //! \brief the number of functions waiting for their time stamp
+    size_t pending_timed() const { return timed.size(); }
+
+    const char* kind() const override { return "async_channel"; }
+
+private:
+    struct entry {
+        bool is_timed;
+        sc_core::sc_time time;
+        std::function<void()> f;
+    };
+
+    void push(entry&& e) {
+        queue.push(std::move(e));
+        // only the first push after a drain needs to wake the kernel
+        if(!update_requested.exchange(true, std::memory_order_acq_rel))
+            async_request_update();
+    }
+
+    void update() override {
+        update_requested.store(false, std::memory_order_release);
+        wakeup.notify(sc_core::SC_ZERO_TIME);
+    }
+
+    void dispatch() {
+        auto const now = sc_core::sc_time_stamp();
+        entry e;
+        while(queue.pop(e)) {
+            if(e.is_timed && e.time > now)
+                timed.emplace(e.time, std::move(e.f));
+            else
+                e.f();
+        }
+        while(!timed.empty() && timed.begin()->first <= now) {
+            auto f = std::move(timed.begin()->second);
+            timed.erase(timed.begin());
+            f();
+        }
+        if(!timed.empty())
+            wakeup.notify(timed.begin()->first - now);
+    }
+
+    util::mpsc_queue<entry> queue;
+    std::atomic<bool> update_requested{false};
+    std::multimap<sc_core::sc_time, std::function<void()>> timed;
+    sc_core::sc_event wakeup;
+};
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif    /* _SCC_ASYNC_CHANNEL_H_ */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_CACHED_PARAM_H_
+#define _SCC_CACHED_PARAM_H_
+
+#include <cci_configuration>
+#include <string>
+#include <sysc/communication/sc_port.h>
+#include <sysc/communication/sc_signal_ifs.h>
+#include <sysc/kernel/sc_dynamic_processes.h>
+
+namespace scc {
+/**
+ * @brief extension of \ref cci_param<T, TM> which mirrors the value of the parameter into a plain member
+ *
+ * The member is updated by a post-write callback so reading the value does not involve the broker. The accessors
+ * get_value() and the conversion operator of cci_param are shadowed to return the mirrored value, hence a
+ * cached_param can replace a cci_param in hot paths without changing the code using it.
+ *
+ * @tparam T type of the parameter value
+ * @tparam TM  specifies the parameter type lock behavior
+ */
+template <typename T, cci::cci_param_mutable_type TM = cci::CCI_MUTABLE_PARAM> struct cached_param : public cci::cci_param<T, TM> {
+
+    /** @name Constructors */
+    //@{
+    /**
+     * Constructor with (local/hierarchical) name, default value, description and originator.
+     *
+     * @param name Name of the parameter
+     * @param default_value Default value of the parameter (Typed value)
+     * @param desc Description of the parameter
+     * @param name_type Either the name should be absolute or relative
+     * @param originator Originator of the parameter
+     */
+    cached_param(const std::string& name, const T& default_value, const std::string& desc = "",
+                 cci::cci_name_type name_type = cci::CCI_RELATIVE_NAME,
+                 const cci::cci_originator& originator = sc_core::sc_get_current_object() ? cci::cci_originator()
+                                                                                          : cci::cci_originator("sc_main"))
+    : cci::cci_param<T, TM>(name, default_value, desc, name_type, originator)
+    , value(cci::cci_param<T, TM>::get_value()) {
+        register_update();
+    }
+    /**
+     * Constructor with (local/hierarchical) name, default value, private broker, description, name type and
+     * originator.
+     *
+     * @param name Name of the parameter
+     * @param default_value Default value of the parameter (Typed value)
+     * @param private_broker Associated private broker
+     * @param desc Description of the parameter
+     * @param name_type Either the name should be absolute or relative
+     * @param originator Originator of the parameter
+     */
+    cached_param(const std::string& name, const T& default_value, cci::cci_broker_handle private_broker, const std::string& desc = "",
+                 cci::cci_name_type name_type = cci::CCI_RELATIVE_NAME,
+                 const cci::cci_originator& originator = sc_core::sc_get_current_object() ? cci::cci_originator()
+                                                                                          : cci::cci_originator("sc_main"))
+    : cci::cci_param<T, TM>(name, default_value, private_broker, desc, name_type, originator)
+    , value(cci::cci_param<T, TM>::get_value()) {
+        register_update();
+    }
+    //@}
+    /**
+     * the assignment operators of cci_param are hidden by the implicit copy assignment, they write the value like a CCI
+     * write hence the mirrored value is updated by the post-write callback
+     */
+    using cci::cci_param<T, TM>::operator=;
+    //! \brief returns the mirrored value of the parameter
+    inline const T& get_value() const { return value; }
+    //! \brief returns the mirrored value of the parameter
+    inline operator const T&() const { return value; }
+
+private:
+    void register_update() {
+        this->register_post_write_callback([this](cci::cci_param_write_event<T> const& ev) { value = ev.new_value; });
+    }
+
+    T value;
+};
+/**
+ * @brief mirrors the value of a signal input port into a plain member
+ *
+ * After start() has been called (e.g. in end_of_elaboration) the value is updated by a method process sensitive to
+ * the value changes of the connected signal. This is intended for slowly changing inputs like clock periods which are
+ * read upon each access. If start() has not been called, e.g. since a subclass overrides the callback calling it,
+ * valid() and get() fall back to checking and reading the port upon each call.
+ *
+ * @tparam T the data type of the signal
+ */
+template <typename T> class cached_port_value {
+public:
+    /**
+     * @brief the constructor
+     *
+     * @param port the port to mirror, it may stay unbound
+     */
+    explicit cached_port_value(sc_core::sc_port_b<sc_core::sc_signal_in_if<T>>& port)
+    : port(port) {}
+    /**
+     * @brief reads the current value and creates the process following the value changes if the port is bound
+     */
+    void start() {
+        started = true;
+        if(!port.get_interface())
+            return;
+        bound = true;
+        value = port->read();
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&port->value_changed_event());
+        sc_core::sc_spawn([this]() { value = port->read(); }, sc_core::sc_gen_unique_name("cached_port_value"), &opts);
+    }
+    //! \brief returns true if the port is bound
+    inline bool valid() const { return started ? bound : port.get_interface() != nullptr; }
+    //! \brief returns the mirrored value resp. the value of the port if start() has not been called
+    inline T get() const { return started ? value : port->read(); }
+
+private:
+    sc_core::sc_port_b<sc_core::sc_signal_in_if<T>>& port;
+    T value{};
+    bool started{false};
+    bool bound{false};
+};
+} // namespace scc
+#endif /* _SCC_CACHED_PARAM_H_ */
@@ -16,6 +16,8 @@
 
 #include "configurable_tracer.h"
 #include "traceable.h"
+#include "utilities.h"
+#include <cstring>
 #include <unordered_set>
 
 using namespace sc_core;
@@ -97,8 +99,7 @@ auto scc::configurable_tracer::get_trace_enabled(const sc_core::sc_object* obj,
         const auto* a = dynamic_cast<const sc_core::sc_attribute<bool>*>(attr);
         return a->value;
     } else {
-        std::string hier_name{obj->name()};
-        auto h = cci_broker.get_param_handle(hier_name.append("." EN_TRACING_STR));
+        auto h = cci_broker.get_param_handle(scc::hier_name(obj, EN_TRACING_STR));
         if(h.is_valid())
             return h.get_cci_value().get_bool();
     }
@@ -109,9 +110,8 @@ void configurable_tracer::augment_object_hierarchical(sc_core::sc_object* obj) {
     if(dynamic_cast<sc_core::sc_module*>(obj) != nullptr || dynamic_cast<scc::traceable*>(obj) != nullptr) {
         auto* attr = obj->get_attribute(EN_TRACING_STR);
         if(attr == nullptr || dynamic_cast<const sc_core::sc_attribute<bool>*>(attr) == nullptr) { // check if we have no sc_attribute
-            std::string hier_name{obj->name()};
-            if(hier_name.substr(0, 11) != "scc_tracer") {
-                hier_name += "." EN_TRACING_STR;
+            if(std::strcmp(obj->name(), "scc_tracer") != 0) {
+                auto const& hier_name = scc::hier_name(obj, EN_TRACING_STR);
                 auto h = cci_broker.get_param_handle(hier_name);
                 if(!h.is_valid()) // we have no cci_param so create one
                     params.push_back(new cci::cci_param<bool>(hier_name, default_trace_enable, cci_broker, "", cci::CCI_ABSOLUTE_NAME,
@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#include "ctf_trace.hh"
+#include "trace/types.hh"
+#include "utilities.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <util/ctf_writer.h>
+#include <vector>
+
+namespace scc {
+namespace trace {
+inline uint64_t get_mask(unsigned bits) { return bits >= 64 ? std::numeric_limits<uint64_t>::max() : (1ULL << bits) - 1; }
+
+template <typename T> inline util::ctf::kind get_kind() { return traits<T>::get_type() == REAL ? util::ctf::REAL : util::ctf::UINT; }
+template <> inline util::ctf::kind get_kind<sc_dt::sc_logic>() { return util::ctf::LOGIC; }
+template <> inline util::ctf::kind get_kind<sc_dt::sc_signed>() { return util::ctf::LOGIC; }
+template <> inline util::ctf::kind get_kind<sc_dt::sc_unsigned>() { return util::ctf::LOGIC; }
+template <> inline util::ctf::kind get_kind<sc_dt::sc_bv_base>() { return util::ctf::LOGIC; }
+template <> inline util::ctf::kind get_kind<sc_dt::sc_lv_base>() { return util::ctf::LOGIC; }
+
+struct ctf_trace {
+
+    ctf_trace(std::string const& nm, util::ctf::kind kind, unsigned bits)
+    : name{nm}
+    , bits{kind == util::ctf::REAL ? 64 : bits}
+    , kind{kind} {}
+
+    virtual void record(util::ctf_writer& w) = 0;
+
+    virtual void update_and_record(util::ctf_writer& w) = 0;
+
+    virtual uintptr_t get_hash() = 0;
+
+    virtual ~ctf_trace(){};
+
+    const std::string name;
+    unsigned id{0};
+    bool is_alias{false};
+    bool is_triggered{false};
+    const unsigned bits{0};
+    const util::ctf::kind kind;
+};
+
+template <typename T, typename OT = T> struct ctf_trace_t : public ctf_trace {
+    ctf_trace_t(const T& object_, const std::string& name, int width = -1)
+    : ctf_trace(name, get_kind<T>(), trace::traits<T>::get_bits(object_))
+    , act_val(object_)
+    , old_val(object_) {}
+
+    uintptr_t get_hash() override { return reinterpret_cast<uintptr_t>(&act_val); }
+
+    inline bool changed() { return !is_alias && old_val != act_val; }
+
+    inline void update() { old_val = act_val; }
+
+    void record(util::ctf_writer& w) override;
+
+    void update_and_record(util::ctf_writer& w) override {
+        update();
+        record(w);
+    };
+
+    OT old_val;
+    const T& act_val;
+};
+
+template <typename T, typename OT> inline void ctf_trace_t<T, OT>::record(util::ctf_writer& w) {
+    w.emit(id, static_cast<uint64_t>(old_val) & get_mask(bits));
+}
+template <> void ctf_trace_t<bool, bool>::record(util::ctf_writer& w) { w.emit(id, static_cast<uint64_t>(old_val)); }
+template <> void ctf_trace_t<sc_dt::sc_bit, sc_dt::sc_bit>::record(util::ctf_writer& w) {
+    w.emit(id, static_cast<uint64_t>(old_val.to_bool()));
+}
+template <> void ctf_trace_t<sc_dt::sc_logic, sc_dt::sc_logic>::record(util::ctf_writer& w) {
+    char buf[2] = {old_val.to_char(), 0};
+    w.emit(id, buf);
+}
+template <> void ctf_trace_t<float, float>::record(util::ctf_writer& w) { w.emit(id, static_cast<double>(old_val)); }
+template <> void ctf_trace_t<double, double>::record(util::ctf_writer& w) { w.emit(id, old_val); }
+template <> void ctf_trace_t<sc_dt::sc_int_base, sc_dt::sc_int_base>::record(util::ctf_writer& w) {
+    w.emit(id, static_cast<uint64_t>(old_val.value()) & get_mask(bits));
+}
+template <> void ctf_trace_t<sc_dt::sc_uint_base, sc_dt::sc_uint_base>::record(util::ctf_writer& w) {
+    w.emit(id, static_cast<uint64_t>(old_val.value()));
+}
+template <> void ctf_trace_t<sc_dt::sc_signed, sc_dt::sc_signed>::record(util::ctf_writer& w) {
+    static std::vector<char> rawdata(1024);
+    if(rawdata.size() < old_val.length() + 1)
+        rawdata.resize(old_val.length() + 1);
+    char* rawdata_ptr = &rawdata[0];
+    for(int bitindex = old_val.length() - 1; bitindex >= 0; --bitindex)
+        *rawdata_ptr++ = '0' + old_val[bitindex].value();
+    w.emit(id, &rawdata[0]);
+}
+template <> void ctf_trace_t<sc_dt::sc_unsigned, sc_dt::sc_unsigned>::record(util::ctf_writer& w) {
+    static std::vector<char> rawdata(1024);
+    if(rawdata.size() < old_val.length() + 1)
+        rawdata.resize(old_val.length() + 1);
+    char* rawdata_ptr = &rawdata[0];
+    for(int bitindex = old_val.length() - 1; bitindex >= 0; --bitindex)
+        *rawdata_ptr++ = '0' + old_val[bitindex].value();
+    w.emit(id, &rawdata[0]);
+}
+template <> void ctf_trace_t<sc_dt::sc_fxval, sc_dt::sc_fxval>::record(util::ctf_writer& w) { w.emit(id, old_val.to_double()); }
+template <> void ctf_trace_t<sc_dt::sc_fxval_fast, sc_dt::sc_fxval_fast>::record(util::ctf_writer& w) {
+    w.emit(id, old_val.to_double());
+}
+template <> void ctf_trace_t<sc_dt::sc_fxnum, sc_dt::sc_fxval>::record(util::ctf_writer& w) { w.emit(id, old_val.to_double()); }
+template <> void ctf_trace_t<sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast>::record(util::ctf_writer& w) {
+    w.emit(id, old_val.to_double());
+}
+template <> void ctf_trace_t<sc_dt::sc_bv_base, sc_dt::sc_bv_base>::record(util::ctf_writer& w) {
+    auto str = old_val.to_string();
+    w.emit(id, str.c_str());
+}
+template <> void ctf_trace_t<sc_dt::sc_lv_base, sc_dt::sc_lv_base>::record(util::ctf_writer& w) {
+    auto str = old_val.to_string();
+    w.emit(id, str.c_str());
+}
+} // namespace trace
+
+ctf_trace_file::ctf_trace_file(const char* name, std::function<bool()>& enable)
+: check_enabled(enable) {
+    std::stringstream ss;
+    ss << name << ".ctf";
+    writer.reset(new util::ctf_writer(ss.str()));
+    if(!writer->is_open()) {
+        fprintf(stderr, "Could not open '%s', exiting.\n", ss.str().c_str());
+        exit(255);
+    }
+#if defined(WITH_SC_TRACING_PHASE_CALLBACKS)
+    // remove from hierarchy
+    sc_object::detach();
+    // register regular (non-delta) callbacks
+    sc_object::register_simulation_phase_callback(SC_BEFORE_TIMESTEP);
+#else // explicitly register with simcontext
+    sc_core::sc_get_curr_simcontext()->add_trace_file(this);
+#endif
+}
+
+ctf_trace_file::~ctf_trace_file() {
+    writer.reset();
+    for(auto t : all_traces)
+        delete t.trc;
+}
+
+template <typename T, typename OT = T> bool changed(trace::ctf_trace* trace) {
+    if(reinterpret_cast<trace::ctf_trace_t<T, OT>*>(trace)->changed()) {
+        reinterpret_cast<trace::ctf_trace_t<T, OT>*>(trace)->update();
+        return true;
+    } else
+        return false;
+}
+#define DECL_TRACE_METHOD_A(tp)                                                                                                            \
+    void ctf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.emplace_back(this, &changed<tp>, new trace::ctf_trace_t<tp>(object, name));                                             \
+    }
+#define DECL_TRACE_METHOD_B(tp)                                                                                                            \
+    void ctf_trace_file::trace(const tp& object, const std::string& name, int width) {                                                     \
+        all_traces.emplace_back(this, &changed<tp>, new trace::ctf_trace_t<tp>(object, name));                                             \
+    }
+#define DECL_TRACE_METHOD_C(tp, tpo)                                                                                                       \
+    void ctf_trace_file::trace(const tp& object, const std::string& name) {                                                                \
+        all_traces.emplace_back(this, &changed<tp, tpo>, new trace::ctf_trace_t<tp, tpo>(object, name));                                   \
+    }
+
+#if(SYSTEMC_VERSION >= 20171012)
+void ctf_trace_file::trace(const sc_core::sc_event& object, const std::string& name) {}
+void ctf_trace_file::trace(const sc_core::sc_time& object, const std::string& name) {}
+#endif
+DECL_TRACE_METHOD_A(bool)
+DECL_TRACE_METHOD_A(sc_dt::sc_bit)
+DECL_TRACE_METHOD_A(sc_dt::sc_logic)
+
+DECL_TRACE_METHOD_B(unsigned char)
+DECL_TRACE_METHOD_B(unsigned short)
+DECL_TRACE_METHOD_B(unsigned int)
+DECL_TRACE_METHOD_B(unsigned long)
+#ifdef SYSTEMC_64BIT_PATCHES
+DECL_TRACE_METHOD_B(unsigned long long)
+#endif
+DECL_TRACE_METHOD_B(char)
+DECL_TRACE_METHOD_B(short)
+DECL_TRACE_METHOD_B(int)
+DECL_TRACE_METHOD_B(long)
+DECL_TRACE_METHOD_B(sc_dt::int64)
+DECL_TRACE_METHOD_B(sc_dt::uint64)
+
+DECL_TRACE_METHOD_A(float)
+DECL_TRACE_METHOD_A(double)
+DECL_TRACE_METHOD_A(sc_dt::sc_int_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_uint_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_signed)
+DECL_TRACE_METHOD_A(sc_dt::sc_unsigned)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval)
+DECL_TRACE_METHOD_A(sc_dt::sc_fxval_fast)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum, sc_dt::sc_fxval)
+DECL_TRACE_METHOD_C(sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast)
+
+DECL_TRACE_METHOD_A(sc_dt::sc_bv_base)
+DECL_TRACE_METHOD_A(sc_dt::sc_lv_base)
+#undef DECL_TRACE_METHOD_A
+#undef DECL_TRACE_METHOD_B
+#undef DECL_TRACE_METHOD_C
+
+void ctf_trace_file::trace(const unsigned int& object, const std::string& name, const char** enum_literals) {
+    all_traces.emplace_back(this, &changed<unsigned int>, new trace::ctf_trace_t<unsigned int>(object, name));
+}
+
+#define DECL_REGISTER_METHOD_A(tp)                                                                                                         \
+    observer::notification_handle* ctf_trace_file::observe(const tp& object, const std::string& name) {                                    \
+        all_traces.emplace_back(this, &changed<tp>, new trace::ctf_trace_t<tp>(object, name));                                             \
+        all_traces.back().trc->is_triggered = true;                                                                                        \
+        return &all_traces.back();                                                                                                         \
+    }
+#define DECL_REGISTER_METHOD_C(tp, tpo)                                                                                                    \
+    observer::notification_handle* ctf_trace_file::observe(const tp& object, const std::string& name) {                                    \
+        all_traces.emplace_back(this, &changed<tp, tpo>, new trace::ctf_trace_t<tp, tpo>(object, name));                                   \
+        all_traces.back().trc->is_triggered = true;                                                                                        \
+        return &all_traces.back();                                                                                                         \
+    }
+#if(SYSTEMC_VERSION >= 20171012)
+observer::notification_handle* ctf_trace_file::observe(const sc_core::sc_event& object, const std::string& name) { return nullptr; }
+observer::notification_handle* ctf_trace_file::observe(const sc_core::sc_time& object, const std::string& name) { return nullptr; }
+#endif
+
+DECL_REGISTER_METHOD_A(bool)
+DECL_REGISTER_METHOD_A(sc_dt::sc_bit)
+DECL_REGISTER_METHOD_A(sc_dt::sc_logic)
+
+DECL_REGISTER_METHOD_A(unsigned char)
+DECL_REGISTER_METHOD_A(unsigned short)
+DECL_REGISTER_METHOD_A(unsigned int)
+DECL_REGISTER_METHOD_A(unsigned long)
+#ifdef SYSTEMC_64BIT_PATCHES
+DECL_REGISTER_METHOD_A(unsigned long long)
+#endif
+DECL_REGISTER_METHOD_A(char)
+DECL_REGISTER_METHOD_A(short)
+DECL_REGISTER_METHOD_A(int)
+DECL_REGISTER_METHOD_A(long)
+DECL_REGISTER_METHOD_A(sc_dt::int64)
+DECL_REGISTER_METHOD_A(sc_dt::uint64)
+
+DECL_REGISTER_METHOD_A(float)
+DECL_REGISTER_METHOD_A(double)
+DECL_REGISTER_METHOD_A(sc_dt::sc_int_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_uint_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_signed)
+DECL_REGISTER_METHOD_A(sc_dt::sc_unsigned)
+
+DECL_REGISTER_METHOD_A(sc_dt::sc_fxval)
+DECL_REGISTER_METHOD_A(sc_dt::sc_fxval_fast)
+DECL_REGISTER_METHOD_C(sc_dt::sc_fxnum, sc_dt::sc_fxval)
+DECL_REGISTER_METHOD_C(sc_dt::sc_fxnum_fast, sc_dt::sc_fxval_fast)
+
+DECL_REGISTER_METHOD_A(sc_dt::sc_bv_base)
+DECL_REGISTER_METHOD_A(sc_dt::sc_lv_base)
+#undef DECL_REGISTER_METHOD_A
+#undef DECL_REGISTER_METHOD_C
+
+bool ctf_trace_file::trace_entry::notify() {
+    if(!trc->is_alias && compare_and_update(trc))
+        that->triggered_traces.push_back(trc);
+    return !trc->is_alias;
+}
+
+void ctf_trace_file::write_comment(const std::string& comment) {}
+
+void ctf_trace_file::init() {
+    std::unordered_map<uintptr_t, unsigned> alias_map;
+    for(auto& e : all_traces) {
+        auto alias_it = alias_map.find(e.trc->get_hash());
+        e.trc->is_alias = alias_it != std::end(alias_map);
+        e.trc->id = writer->add_signal(e.trc->name, e.trc->kind, e.trc->bits, e.trc->is_alias ? static_cast<int>(alias_it->second) : -1);
+        if(!e.trc->is_alias)
+            alias_map.insert({e.trc->get_hash(), e.trc->id});
+        if(!(e.trc->is_alias || e.trc->is_triggered))
+            pull_traces.push_back(&e);
+    }
+    changed_traces.reserve(pull_traces.size());
+    triggered_traces.reserve(all_traces.size());
+}
+
+void ctf_trace_file::cycle(bool delta_cycle) {
+    if(delta_cycle)
+        return;
+    if(last_emitted_ts == std::numeric_limits<uint64_t>::max()) {
+        init();
+        uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+        writer->set_time(time_stamp);
+        for(auto& e : all_traces)
+            if(!e.trc->is_alias)
+                e.trc->update_and_record(*writer);
+        last_emitted_ts = time_stamp;
+    } else {
+        if(check_enabled && !check_enabled())
+            return;
+        for(auto e : pull_traces) {
+            if(e->compare_and_update(e->trc))
+                changed_traces.push_back(e->trc);
+        }
+        if(triggered_traces.size() || changed_traces.size()) {
+            uint64_t time_stamp = sc_core::sc_time_stamp().value() / (1_ps).value();
+            writer->set_time(time_stamp);
+            if(triggered_traces.size()) {
+                auto end = std::unique(std::begin(triggered_traces), std::end(triggered_traces));
+                triggered_traces.erase(end, triggered_traces.end());
+                for(auto t : triggered_traces)
+                    t->record(*writer);
+                triggered_traces.clear();
+            }
+            if(changed_traces.size()) {
+                for(auto t : changed_traces)
+                    t->record(*writer);
+                changed_traces.clear();
+            }
+            last_emitted_ts = time_stamp;
+        }
+    }
+}
+
+void ctf_trace_file::set_time_unit(double v, sc_core::sc_time_unit tu) {}
+#ifdef NCSC
+void ctf_trace_file::set_time_unit(int exponent10_seconds) {}
+#endif
+
+sc_core::sc_trace_file* create_ctf_trace_file(const char* name, std::function<bool()> enable) { return new ctf_trace_file(name, enable); }
+
+void close_ctf_trace_file(sc_core::sc_trace_file* tf) { delete static_cast<ctf_trace_file*>(tf); }
+
+} // namespace scc
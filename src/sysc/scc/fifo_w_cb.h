@@ -18,7 +18,11 @@
 
 #include <deque>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <sysc/communication/sc_prim_channel.h>
+#include <sysc/utils/sc_report.h>
 
 /** \ingroup scc-sysc
  *  @{
@@ -115,5 +119,149 @@ protected:
     sc_core::sc_event data_written_evt{};
 };
 
+/**
+ * @class ring_fifo_w_cb
+ * @brief bounded fifo with callbacks based on a ring buffer
+ *
+ * A variant of \ref fifo_w_cb with a fixed capacity. The elements are kept in a single ring buffer, the update only
+ * moves the boundary between the visible and the pending part, hence no element is copied or allocated after
+ * construction. Elements may be move-only and can be constructed in place. Back-pressure is signaled by the full event
+ * and the data read event.
+ *
+ * @tparam T the type name of the elements to be store in the fifo
+ */
+template <typename T> class ring_fifo_w_cb : public sc_core::sc_prim_channel {
+public:
+    /**
+     * @brief the constructor
+     *
+     * @param name the name of the channel
+     * @param capacity the maximum number of elements (visible and pending), rounded up to a power of two
+     */
+    explicit ring_fifo_w_cb(const char* name = sc_core::sc_gen_unique_name("ring_fifo_w_cb"), size_t capacity = 16)
+    : sc_core::sc_prim_channel(name) {
+        size_t cap = 1;
+        while(cap < capacity)
+            cap <<= 1;
+        mask = cap - 1;
+        storage.reset(new slot_type[cap]);
+    }
+
+    ring_fifo_w_cb(ring_fifo_w_cb const&) = delete;
+    ring_fifo_w_cb& operator=(ring_fifo_w_cb const&) = delete;
+
+    virtual ~ring_fifo_w_cb() {
+        for(; head != tail; ++head)
+            at(head).~T();
+    }
+    /**
+     * @brief constructs an element in place at the end of the fifo
+     *
+     * @return false if the fifo is full
+     */
+    template <typename... Args> bool emplace_back(Args&&... args) {
+        if(full())
+            return false;
+        new(&storage[tail & mask]) T(std::forward<Args>(args)...);
+        ++tail;
+        request_update();
+        if(full())
+            full_evt.notify(sc_core::SC_ZERO_TIME);
+        return true;
+    }
+
+    bool push_back(const T& t) { return emplace_back(t); }
+
+    bool push_back(T&& t) { return emplace_back(std::move(t)); }
+    /**
+     * @brief blocking write, waits until there is space in the fifo
+     */
+    void write(T t) {
+        while(full())
+            wait(data_read_evt);
+        emplace_back(std::move(t));
+    }
+
+    T& back() { return at(tail - 1); }
+    const T& back() const { return at(tail - 1); }
+
+    void pop_front() {
+        sc_assert(!empty());
+        at(head).~T();
+        ++head;
+        request_update();
+        if(empty_cb && head == visible_end)
+            empty_cb();
+    }
+
+    T& front() { return at(head); }
+    const T& front() const { return at(head); }
+
+    T read() {
+        while(empty())
+            wait(data_written_evt);
+        auto val = std::move(front());
+        pop_front();
+        return val;
+    }
+    //! \brief the number of visible elements
+    size_t avail() const { return visible_end - head; }
+    //! \brief true if there are no visible elements
+    bool empty() const { return head == visible_end; }
+    //! \brief true if no further element can be written
+    bool full() const { return tail - head > mask; }
+    //! \brief the number of elements which can be written
+    size_t num_free() const { return mask + 1 - (tail - head); }
+    //! \brief the maximum number of elements
+    size_t capacity() const { return mask + 1; }
+
+    void set_avail_cb(std::function<void(void)> f) { avail_cb = f; }
+    void set_empty_cb(std::function<void(void)> f) { empty_cb = f; }
+
+    inline sc_core::sc_event const& data_written_event() const { return data_written_evt; }
+    //! \brief notified in the delta cycle after elements have been removed
+    inline sc_core::sc_event const& data_read_event() const { return data_read_evt; }
+    //! \brief notified in the delta cycle after the fifo became full
+    inline sc_core::sc_event const& full_event() const { return full_evt; }
+
+    inline unsigned num_avail() { return available; }
+    inline unsigned num_written() { return written; }
+
+    const char* kind() const override { return "ring_fifo_w_cb"; }
+
+protected:
+    using slot_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    T& at(size_t idx) { return *reinterpret_cast<T*>(&storage[idx & mask]); }
+    const T& at(size_t idx) const { return *reinterpret_cast<T const*>(&storage[idx & mask]); }
+
+    void update() override {
+        if(head != last_head) {
+            last_head = head;
+            data_read_evt.notify(sc_core::SC_ZERO_TIME);
+        }
+        written = static_cast<unsigned>(tail - visible_end);
+        visible_end = tail;
+        available = static_cast<unsigned>(visible_end - head);
+        if(!written)
+            return;
+        if(avail_cb)
+            avail_cb();
+        data_written_evt.notify(sc_core::SC_ZERO_TIME);
+    }
+
+    std::unique_ptr<slot_type[]> storage;
+    size_t mask{0};
+    // monotonic indexes: [head, visible_end) is visible, [visible_end, tail) becomes visible with the next update
+    size_t head{0}, visible_end{0}, tail{0}, last_head{0};
+    std::function<void(void)> avail_cb{};
+    std::function<void(void)> empty_cb{};
+    unsigned available = 0;
+    unsigned written = 0;
+    sc_core::sc_event data_written_evt{};
+    sc_core::sc_event data_read_evt{};
+    sc_core::sc_event full_evt{};
+};
+
 } /* namespace scc */
 /** @} */ // end of scc-sysc
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _SCC_FIXED_BV_H_
+#define _SCC_FIXED_BV_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <sysc/datatypes/int/sc_biguint.h>
+#include <sysc/tracing/sc_trace.h>
+#include <type_traits>
+
+/** \ingroup scc-sysc
+ *  @{
+ */
+/**@{*/
+//! @brief SCC SystemC utilities
+namespace scc {
+/**
+ * @brief a fixed width, trivially copyable bit vector
+ *
+ * The bits are kept in an array of 64bit words (bit 0 is the LSB of the first word), hence copying and comparing
+ * compiles to a few word operations. It is meant as value type of wide data signals (e.g. 512bit busses) instead of
+ * sc_dt::sc_biguint and provides the part of its interface used there: construction from integers, range selects of
+ * up to 64 bits using range() or operator(), and conversion from and to sc_dt::sc_biguint. Bits above W are always
+ * zero.
+ *
+ * @tparam W the width in bits
+ */
+template <unsigned W> struct fixed_bv {
+    static_assert(W > 0, "the width of fixed_bv needs to be larger than 0");
+    //! the width in bits
+    static constexpr unsigned width = W;
+    //! the number of 64bit words used as storage
+    static constexpr unsigned word_count = (W + 63) / 64;
+    using storage_type = std::array<uint64_t, word_count>;
+    /**
+     * @brief a reference to a range of up to 64 bits
+     */
+    struct range_ref {
+        range_ref& operator=(uint64_t v) {
+            bv.set_range(hi, lo, v);
+            return *this;
+        }
+        range_ref& operator=(range_ref const& o) { return *this = o.to_uint64(); }
+        uint64_t to_uint64() const { return bv.get_range(hi, lo); }
+        unsigned to_uint() const { return static_cast<unsigned>(to_uint64()); }
+        operator uint64_t() const { return to_uint64(); }
+
+        fixed_bv& bv;
+        unsigned const hi;
+        unsigned const lo;
+    };
+    /**
+     * @brief a read-only reference to a range of up to 64 bits
+     */
+    struct const_range_ref {
+        uint64_t to_uint64() const { return bv.get_range(hi, lo); }
+        unsigned to_uint() const { return static_cast<unsigned>(to_uint64()); }
+        operator uint64_t() const { return to_uint64(); }
+
+        fixed_bv const& bv;
+        unsigned const hi;
+        unsigned const lo;
+    };
+
+    fixed_bv() = default;
+
+    fixed_bv(uint64_t v) {
+        words[0] = v;
+        mask_top();
+    }
+
+    fixed_bv(sc_dt::sc_unsigned const& v) {
+        for(unsigned i = 0; i < word_count; ++i) {
+            auto const hi = std::min(W, 64 * i + 64) - 1;
+            if(64 * i < static_cast<unsigned>(v.length()))
+                words[i] = v.range(std::min<int>(hi, v.length() - 1), 64 * i).to_uint64();
+        }
+    }
+    //! \brief converts the value to an arbitrary precision integer
+    sc_dt::sc_biguint<W> to_biguint() const {
+        sc_dt::sc_biguint<W> ret{0};
+        for(unsigned i = 0; i < word_count; ++i)
+            ret.range(std::min(W, 64 * i + 64) - 1, 64 * i) = words[i];
+        return ret;
+    }
+
+    //! \brief the lowest 64 bits
+    uint64_t to_uint64() const { return words[0]; }
+    //! \brief the lowest 32 bits
+    unsigned to_uint() const { return static_cast<unsigned>(words[0]); }
+
+    range_ref range(unsigned hi, unsigned lo) {
+        check_range(hi, lo);
+        return range_ref{*this, hi, lo};
+    }
+    const_range_ref range(unsigned hi, unsigned lo) const {
+        check_range(hi, lo);
+        return const_range_ref{*this, hi, lo};
+    }
+    range_ref operator()(unsigned hi, unsigned lo) { return range(hi, lo); }
+    const_range_ref operator()(unsigned hi, unsigned lo) const { return range(hi, lo); }
+
+    bool operator[](unsigned i) const { return get_bit(i); }
+    bool get_bit(unsigned i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    void set_bit(unsigned i, bool v) {
+        if(v)
+            words[i / 64] |= uint64_t(1) << (i % 64);
+        else
+            words[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+    /**
+     * @brief reads the bits hi..lo, lo <= hi < lo+64
+     *
+     * @return the value of the range
+     */
+    uint64_t get_range(unsigned hi, unsigned lo) const {
+        auto const n = hi - lo + 1;
+        auto const w = lo / 64;
+        auto const b = lo % 64;
+        auto v = words[w] >> b;
+        if(b && b + n > 64 && w + 1 < word_count)
+            v |= words[w + 1] << (64 - b);
+        return n == 64 ? v : v & ((uint64_t(1) << n) - 1);
+    }
+    /**
+     * @brief writes the bits hi..lo, lo <= hi < lo+64
+     *
+     * @param v the value, bits above the range width are ignored
+     */
+    void set_range(unsigned hi, unsigned lo, uint64_t v) {
+        auto const n = hi - lo + 1;
+        auto const w = lo / 64;
+        auto const b = lo % 64;
+        auto const m = n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+        v &= m;
+        words[w] = (words[w] & ~(m << b)) | (v << b);
+        if(b && b + n > 64 && w + 1 < word_count)
+            words[w + 1] = (words[w + 1] & ~(m >> (64 - b))) | (v >> (64 - b));
+    }
+    //! \brief direct access to the storage words
+    storage_type const& get_words() const { return words; }
+    //! \brief direct access to the storage words, the caller has to keep bits above W cleared
+    storage_type& get_words() { return words; }
+
+    bool operator==(fixed_bv const& o) const { return words == o.words; }
+    bool operator!=(fixed_bv const& o) const { return words != o.words; }
+
+    fixed_bv& operator&=(fixed_bv const& o) {
+        for(unsigned i = 0; i < word_count; ++i)
+            words[i] &= o.words[i];
+        return *this;
+    }
+    fixed_bv& operator|=(fixed_bv const& o) {
+        for(unsigned i = 0; i < word_count; ++i)
+            words[i] |= o.words[i];
+        return *this;
+    }
+    fixed_bv& operator^=(fixed_bv const& o) {
+        for(unsigned i = 0; i < word_count; ++i)
+            words[i] ^= o.words[i];
+        return *this;
+    }
+    fixed_bv operator~() const {
+        fixed_bv ret;
+        for(unsigned i = 0; i < word_count; ++i)
+            ret.words[i] = ~words[i];
+        ret.mask_top();
+        return ret;
+    }
+    friend fixed_bv operator&(fixed_bv a, fixed_bv const& b) { return a &= b; }
+    friend fixed_bv operator|(fixed_bv a, fixed_bv const& b) { return a |= b; }
+    friend fixed_bv operator^(fixed_bv a, fixed_bv const& b) { return a ^= b; }
+    //! \brief the hexadecimal representation of the value with a leading 0x
+    std::string to_string() const {
+        std::ostringstream os;
+        os << "0x" << std::hex << std::setfill('0');
+        for(unsigned i = word_count; i > 0; --i)
+            os << std::setw(16) << words[i - 1];
+        return os.str();
+    }
+
+private:
+    void check_range(unsigned hi, unsigned lo) const {
+        assert(lo <= hi && hi < W && hi - lo < 64 && "fixed_bv supports only ranges of up to 64 bits");
+    }
+    void mask_top() {
+        if(W % 64)
+            words[word_count - 1] &= (uint64_t(1) << (W % 64)) - 1;
+    }
+    storage_type words{};
+};
+
+template <unsigned W> inline std::ostream& operator<<(std::ostream& os, fixed_bv<W> const& v) { return os << v.to_string(); }
+/**
+ * @brief traces a fixed_bv. Values of up to 64 bits are traced as a single variable, wider values as one variable
+ * per storage word named <name>_w<index> with word 0 holding the LSBs.
+ *
+ * @param tf the trace file
+ * @param v the value
+ * @param name the name of the traced value
+ */
+template <unsigned W> inline void sc_trace(sc_core::sc_trace_file* tf, fixed_bv<W> const& v, std::string const& name) {
+    auto const& words = v.get_words();
+    if(W <= 64)
+        sc_core::sc_trace(tf, words[0], name, W);
+    else
+        for(unsigned i = 0; i < fixed_bv<W>::word_count; ++i)
+            sc_core::sc_trace(tf, words[i], name + "_w" + std::to_string(i), i == fixed_bv<W>::word_count - 1 && W % 64 ? W % 64 : 64);
+}
+
+template <unsigned W> inline void sc_trace(sc_core::sc_trace_file* tf, fixed_bv<W> const& v, char const* name) {
+    sc_trace(tf, v, std::string(name));
+}
+} // namespace scc
+/** @} */ // end of scc-sysc
+#endif /* _SCC_FIXED_BV_H_ */
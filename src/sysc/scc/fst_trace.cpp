@@ -29,6 +29,7 @@
 #include <stdexcept>
 #include <unordered_map>
 #include <util/ities.h>
+#include <util/string_interner.h>
 #include <vector>
 
 namespace scc {
@@ -379,16 +380,18 @@ void fst_trace_file::write_comment(const std::string& comment) {}
 namespace {
 struct scope_stack {
     void add_trace(trace::fst_trace* trace) {
-        auto hier = util::split(trace->name, '.');
+        // the name components are kept as symbols of the string interner, they are shared among all traces
+        auto& interner = util::string_interner::get();
+        auto hier = interner.components(interner.intern_path(trace->name));
         add_trace_rec(std::begin(hier), std::end(hier), trace);
     }
 
     void writeScopes(void* fst, std::unordered_map<uintptr_t, fstHandle>& alias_map, const char* scope_name = nullptr) {
+        auto& interner = util::string_interner::get();
         if(m_traces.size() || scope_name) {
             fstWriterSetScope(fst, FST_ST_VCD_SCOPE, scope_name ? scope_name : "SystemC", nullptr);
             for(auto& e : m_traces) {
-                auto hier_tokens = util::split(e.second->name, '.');
-                auto sig_name = hier_tokens.back();
+                auto const& sig_name = interner.str(e.first);
                 auto alias_it = alias_map.find(e.second->get_hash());
                 e.second->is_alias = alias_it != std::end(alias_map);
                 e.second->fst_hndl =
@@ -398,11 +401,11 @@ struct scope_stack {
                     alias_map.insert({e.second->get_hash(), e.second->fst_hndl});
             }
             for(auto& e : m_scopes)
-                e.second->writeScopes(fst, alias_map, e.first.c_str());
+                e.second->writeScopes(fst, alias_map, interner.str(e.first).c_str());
             fstWriterSetUpscope(fst);
         } else
             for(auto& e : m_scopes)
-                e.second->writeScopes(fst, alias_map, e.first.c_str());
+                e.second->writeScopes(fst, alias_map, interner.str(e.first).c_str());
     }
 
     ~scope_stack() {
@@ -411,7 +414,8 @@ struct scope_stack {
     }
 
 private:
-    void add_trace_rec(std::vector<std::string>::iterator beg, std::vector<std::string>::iterator const& end, trace::fst_trace* trace) {
+    using symbol_id = util::string_interner::id_type;
+    void add_trace_rec(std::vector<symbol_id>::iterator beg, std::vector<symbol_id>::iterator const& end, trace::fst_trace* trace) {
         if(std::distance(beg, end) == 1) {
             m_traces.push_back(std::make_pair(*beg, trace));
         } else {
@@ -421,8 +425,8 @@ private:
             sc->second->add_trace_rec(++beg, end, trace);
         }
     }
-    std::vector<std::pair<std::string, trace::fst_trace*>> m_traces{0};
-    std::unordered_map<std::string, scope_stack*> m_scopes{0};
+    std::vector<std::pair<symbol_id, trace::fst_trace*>> m_traces{0};
+    std::unordered_map<symbol_id, scope_stack*> m_scopes{0};
 };
 
 } // namespace
@@ -37,6 +37,7 @@
 #include <tlm>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/string_interner.h>
 
 #include <string>
 #include <typeinfo>
@@ -67,47 +68,59 @@ template <class T> std::string type(const T& t) { return demangle(typeid(t).name
 
 unsigned object_counter{0};
 
+// names and types are kept in the string interner, hierarchical names are interned as paths. This way repeated
+// names and types as well as the common prefixes of the hierarchical names are stored only once.
+using path_id = util::string_interner::id_type;
+inline path_id path_of(sc_core::sc_object const* obj) { return util::string_interner::get().intern_path(obj->name()); }
+inline std::string const& interned(std::string const& s) {
+    auto& interner = util::string_interner::get();
+    return interner.str(interner.intern(s));
+}
+
 struct Module;
 
 struct Port {
-    std::string const fullname;
-    std::string const name;
+    std::string const& fullname;
+    std::string const& name;
     void const* port_if{nullptr};
     bool input{false};
-    std::string const type;
-    std::string const sig_name;
+    std::string const& type;
+    std::string const& sig_name;
     std::string const id{fmt::format("{}", ++object_counter)};
     Module* const owner;
 
-    Port(std::string const& fullname, std::string const& name, void const* ptr, bool input, std::string const& type, Module& owner,
+    Port(path_id path, std::string const& name, void const* ptr, bool input, std::string const& type, Module& owner,
          std::string const& sig_name = "")
-    : fullname(fullname)
-    , name(name)
+    : fullname(util::string_interner::get().path_str(path))
+    , name(interned(name))
     , port_if(ptr)
     , input(input)
-    , type(type)
-    , sig_name(sig_name)
+    , type(interned(type))
+    , sig_name(interned(sig_name))
     , owner(&owner) {}
 };
 
 struct Module {
-    std::string const fullname;
-    std::string const name;
-    std::string const type;
+    path_id const path;
+    std::string const& fullname;
+    std::string const& name;
+    std::string const& type;
     Module* const parent;
     std::string const id{fmt::format("{}", ++object_counter)};
     std::deque<std::unique_ptr<Module>> submodules;
     std::deque<Port> ports;
 
-    Module(std::string const& fullname, std::string const& name, std::string const& type, Module& parent)
-    : fullname(fullname)
-    , name(name)
-    , type(type)
+    Module(path_id path, std::string const& name, std::string const& type, Module& parent)
+    : path(path)
+    , fullname(util::string_interner::get().path_str(path))
+    , name(interned(name))
+    , type(interned(type))
     , parent(&parent) {}
-    Module(std::string const& fullname, std::string const& name, std::string const& type)
-    : fullname(fullname)
-    , name(name)
-    , type(type)
+    Module(path_id path, std::string const& name, std::string const& type)
+    : path(path)
+    , fullname(util::string_interner::get().path_str(path))
+    , name(interned(name))
+    , type(interned(type))
     , parent(nullptr) {}
 };
 
@@ -159,7 +172,7 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
     SCCDEBUG() << indent * level << obj->name() << "(" << obj->kind() << "), id=" << (object_counter + 1);
     std::string kind{obj->kind()};
     if(auto const* mod = dynamic_cast<sc_core::sc_module const*>(obj)) {
-        currentModule.submodules.emplace_back(new Module(obj->name(), name, type(*obj), currentModule));
+        currentModule.submodules.emplace_back(new Module(path_of(obj), name, type(*obj), currentModule));
         std::unordered_set<std::string> keep_outs;
         for(auto* child : mod->get_child_objects()) {
             const std::string child_name{child->basename()};
@@ -179,19 +192,20 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
         }
     } else if(kind == "sc_clock") {
         sc_core::sc_prim_channel const* prim_chan = dynamic_cast<sc_core::sc_prim_channel const*>(obj);
-        currentModule.submodules.emplace_back(new Module(obj->name(), name, type(*obj), currentModule));
-        currentModule.submodules.back()->ports.push_back(Port(std::string(obj->name()) + "." + name, name, prim_chan, false, obj->kind(),
-                                                              *currentModule.submodules.back(), obj->basename()));
+        currentModule.submodules.emplace_back(new Module(path_of(obj), name, type(*obj), currentModule));
+        auto& clk_mod = *currentModule.submodules.back();
+        auto clk_path = util::string_interner::get().intern_child(clk_mod.path, name);
+        clk_mod.ports.push_back(Port(clk_path, name, prim_chan, false, obj->kind(), clk_mod, obj->basename()));
 #ifndef NO_TLM_EXTRACT
 #ifndef NCSC
     } else if(auto const* tptr = dynamic_cast<tlm::tlm_base_socket_if const*>(obj)) {
         auto cat = tptr->get_socket_category();
         bool input = (cat & tlm::TLM_TARGET_SOCKET) == tlm::TLM_TARGET_SOCKET;
         if(input) {
-            currentModule.ports.push_back(Port(obj->name(), name, GET_EXPORT_IF(tptr), input, kind, currentModule));
+            currentModule.ports.push_back(Port(path_of(obj), name, GET_EXPORT_IF(tptr), input, kind, currentModule));
             return {name + "_port", name + "_port_0"};
         } else {
-            currentModule.ports.push_back(Port(obj->name(), name, GET_PORT_IF(tptr), input, kind, currentModule));
+            currentModule.ports.push_back(Port(path_of(obj), name, GET_PORT_IF(tptr), input, kind, currentModule));
             return {name + "_export", name + "_export_0"};
         }
 #endif
@@ -200,15 +214,15 @@ std::vector<std::string> scan_object(sc_core::sc_object const* obj, Module& curr
         sc_core::sc_interface const* if_ptr = optr->get_interface();
         sc_core::sc_prim_channel const* if_obj = dynamic_cast<sc_core::sc_prim_channel const*>(if_ptr);
         bool is_input = kind == "sc_in" || kind == "sc_fifo_in";
-        currentModule.ports.push_back(Port(obj->name(), name, if_obj ? static_cast<void const*>(if_obj) : static_cast<void const*>(if_ptr),
+        currentModule.ports.push_back(Port(path_of(obj), name, if_obj ? static_cast<void const*>(if_obj) : static_cast<void const*>(if_ptr),
                                            is_input, obj->kind(), currentModule, if_obj ? if_obj->basename() : ""));
     } else if(auto const* optr = dynamic_cast<sc_core::sc_export_base const*>(obj)) {
         sc_core::sc_interface const* pointer = optr->get_interface();
-        currentModule.ports.push_back(Port(obj->name(), name, pointer, true, obj->kind(), currentModule));
+        currentModule.ports.push_back(Port(path_of(obj), name, pointer, true, obj->kind(), currentModule));
 #if defined(RECORD_UVM_ANALYSIS)
     } else if(kind == "sc_object" && dynamic_cast<sc_core::sc_interface const*>(obj)) {
         auto const* ifptr = dynamic_cast<sc_core::sc_interface const*>(obj);
-        currentModule.ports.push_back(Port(obj->name(), name, ifptr, false, obj->kind(), currentModule));
+        currentModule.ports.push_back(Port(path_of(obj), name, ifptr, false, obj->kind(), currentModule));
 #endif
     } else if(ignored_entities.find(kind) == ignored_entities.end()) {
         SCCWARN() << "object not known (" << kind << ")";
@@ -274,10 +288,9 @@ void infer_implicit_ports(Module& m) {
                             auto port_iter = std::find_if(std::begin(mod->ports), std::end(mod->ports),
                                                           [port_if](Port const& p) -> bool { return p.port_if == port_if; });
                             if(port_iter == std::end(mod->ports) && upwards == last_upwards) {
-                                std::ostringstream oss;
                                 auto ref_port = upwards ? start_port : end_port;
-                                oss << mod->fullname << "." << ref_port->name;
-                                mod->ports.push_back(Port(oss.str(), ref_port->name, port_if, !upwards, ref_port->type, *mod));
+                                auto port_path = util::string_interner::get().intern_child(mod->path, ref_port->name);
+                                mod->ports.push_back(Port(port_path, ref_port->name, port_if, !upwards, ref_port->type, *mod));
                             }
                             last_upwards = upwards;
                             bread_crumb.pop_back();
@@ -599,13 +612,13 @@ std::unique_ptr<Module> scan_object_tree() {
     std::vector<sc_core::sc_object*> obja = sc_core::sc_get_top_level_objects();
     if(obja.size() == 1 && std::string(obja[0]->kind()) == "sc_module" && std::string(obja[0]->basename()).substr(0, 3) != "$$$") {
         SCCDEBUG() << obja[0]->name() << "(" << obja[0]->kind() << ")";
-        auto topModule = scc::make_unique<Module>(obja[0]->name(), obja[0]->basename(), type(*obja[0]));
+        auto topModule = scc::make_unique<Module>(path_of(obja[0]), obja[0]->basename(), type(*obja[0]));
         for(auto* child : obja[0]->get_child_objects())
             scan_object(child, *topModule, 1);
         return topModule;
     } else {
         SCCDEBUG() << "sc_main ( function sc_main() )";
-        auto topModule = scc::make_unique<Module>("sc_main", "sc_main", "sc_main()");
+        auto topModule = scc::make_unique<Module>(util::string_interner::get().intern_path("sc_main"), "sc_main", "sc_main()");
         for(auto* child : obja)
             scan_object(child, *topModule, 1);
         return topModule;
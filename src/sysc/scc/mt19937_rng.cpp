@@ -20,25 +20,34 @@
 #include <unordered_map>
 
 namespace {
+template <typename ENGINE> struct engines {
+    ENGINE global;
+    std::unordered_map<void*, ENGINE> inst;
+    // the engine of the most recent lookup, the same process usually draws several numbers in a row
+    void* last_obj{nullptr};
+    ENGINE* last{nullptr};
+};
+
 struct {
-    std::mt19937_64 global;
-    std::unordered_map<void*, std::mt19937_64> inst;
+    engines<std::mt19937_64> mt;
+    engines<util::xoshiro256ss> xoshiro;
     uint64_t seed{std::mt19937_64::default_seed};
     bool global_seed;
 } rng;
 
 bool debug_randomization = getenv("SCC_DEBUG_RANDOMIZATION") != nullptr;
-}; // namespace
 
-auto scc::MT19937::inst() -> std::mt19937_64& {
+template <typename ENGINE> ENGINE& get_engine(engines<ENGINE>& e, sc_core::sc_object* obj) {
 #ifndef NCSC
-    if(auto* obj = sc_core::sc_get_current_object()) {
-        auto sz = rng.inst.size();
-        auto& ret = rng.inst[obj];
-        if(rng.inst.size() > sz) {
+    if(obj) {
+        if(obj == e.last_obj && !debug_randomization)
+            return *e.last;
+        auto sz = e.inst.size();
+        auto& ret = e.inst[obj];
+        if(e.inst.size() > sz) {
             uint64_t seed{0};
             if(rng.global_seed) {
-                seed = reinterpret_cast<uintptr_t>(&rng.inst) ^ rng.seed;
+                seed = reinterpret_cast<uintptr_t>(&rng.mt.inst) ^ rng.seed;
                 if(debug_randomization)
                     std::cout << "seeding rng for " << obj->name() << " with global seed " << seed << "\n";
             } else {
@@ -53,17 +62,49 @@ auto scc::MT19937::inst() -> std::mt19937_64& {
         if(debug_randomization) {
             std::cout << "retrieving next rnd number for " << obj->name() << "\n";
         }
+        e.last_obj = obj;
+        e.last = &ret;
         return ret;
     }
 #endif
-    return rng.global;
+    return e.global;
+}
+
+template <typename ENGINE> void reseed(engines<ENGINE>& e, uint64_t new_seed) {
+    e.global.seed(new_seed);
+    for(auto& i : e.inst)
+        i.second.seed(new_seed);
+}
+}; // namespace
+
+auto scc::MT19937::inst() -> std::mt19937_64& {
+#ifndef NCSC
+    return get_engine(rng.mt, sc_core::sc_get_current_object());
+#else
+    return rng.mt.global;
+#endif
+}
+
+auto scc::MT19937::get_handle(sc_core::sc_object* obj) -> handle {
+#ifndef NCSC
+    return handle(get_engine(rng.mt, obj ? obj : sc_core::sc_get_current_object()));
+#else
+    return handle(rng.mt.global);
+#endif
+}
+
+auto scc::MT19937::get_fast_handle(sc_core::sc_object* obj) -> fast_handle {
+#ifndef NCSC
+    return fast_handle(get_engine(rng.xoshiro, obj ? obj : sc_core::sc_get_current_object()));
+#else
+    return fast_handle(rng.xoshiro.global);
+#endif
 }
 
 void scc::MT19937::seed(uint64_t new_seed) {
     rng.seed = new_seed;
-    rng.global.seed(new_seed);
-    for(auto& e : rng.inst)
-        e.second.seed(new_seed);
+    reseed(rng.mt, new_seed);
+    reseed(rng.xoshiro, new_seed);
 }
 
 void scc::MT19937::enable_global_seed(bool enable) { rng.global_seed = enable; }
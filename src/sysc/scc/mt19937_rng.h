@@ -18,8 +18,14 @@
 #define _SCC_MT19937_RNG_H_
 
 #include <assert.h>
+#include <cstddef>
 #include <iostream>
 #include <random>
+#include <util/xoshiro256.h>
+
+namespace sc_core {
+class sc_object;
+}
 
 /** \ingroup scc-sysc
  *  @{
@@ -34,9 +40,133 @@ namespace scc {
  * This random number generator provides various distribution of random numbers being specific to the SystemC process
  * invoking the generator function. This makes the generator independent of the order of invocation in a delta cycle and
  * allows to replay with the same seed
+ *
+ * The static functions look up the generator of the current process upon each call. Code drawing many numbers should
+ * obtain a handle once using get_handle() and use it instead, the handle refers to the same engine hence the sequence
+ * of numbers is the same as with the static functions. get_fast_handle() provides the same for a xoshiro256** engine
+ * which is seeded the same way but is considerably faster than the Mersenne-Twister.
  */
 class MT19937 {
 public:
+    /**
+     * @brief a handle to the random engine of a particular SystemC object (usually a process)
+     *
+     * It is cheap to copy and stays valid for the whole simulation, reseeding using MT19937::seed() affects it.
+     *
+     * @tparam ENGINE the random engine type
+     */
+    template <typename ENGINE> class rng_handle {
+    public:
+        using engine_type = ENGINE;
+        //! \brief the next random integer number with uniform distribution
+        uint64_t uniform() {
+            std::uniform_int_distribution<uint64_t> u;
+            return u(*eng);
+        }
+        //! \brief the next random integer number with uniform distribution in the range of the given type
+        template <typename T> T uniform() {
+            std::uniform_int_distribution<T> u;
+            return u(*eng);
+        }
+        //! \brief the next random integer number with uniform distribution between (and including) min and max
+        uint64_t uniform(uint64_t min, uint64_t max) {
+            assert(min < max);
+            std::uniform_int_distribution<uint64_t> u(min, max);
+            return u(*eng);
+        }
+        //! \brief the next random double precision float number with normal distribution
+        double normal() {
+            std::normal_distribution<> u;
+            return u(*eng);
+        }
+        //! \brief the next random double precision float number with log normal distribution
+        double lognormal() {
+            std::lognormal_distribution<> u;
+            return u(*eng);
+        }
+        /**
+         * @brief fills a buffer with random numbers with uniform distribution between (and including) min and max
+         *
+         * @param buf the buffer
+         * @param n the number of elements
+         * @param min the lower limit of the interval
+         * @param max the upper limit of the interval
+         */
+        template <typename T> void fill_uniform(T* buf, size_t n, T min, T max) {
+            std::uniform_int_distribution<T> u(min, max);
+            for(size_t i = 0; i < n; ++i)
+                buf[i] = u(*eng);
+        }
+        /**
+         * @brief fills a buffer with random bytes, 8 bytes are taken from each number drawn
+         *
+         * @param buf the buffer
+         * @param n the number of bytes
+         */
+        void fill_bytes(uint8_t* buf, size_t n) {
+            for(size_t i = 0; i < n; i += 8) {
+                auto v = static_cast<uint64_t>((*eng)());
+                for(size_t j = i; j < n && j < i + 8; ++j, v >>= 8)
+                    buf[j] = static_cast<uint8_t>(v);
+            }
+        }
+        /**
+         * @brief fills a buffer with random numbers with normal distribution. As a single distribution object is
+         * used for all elements the sequence differs from calling normal() n times.
+         *
+         * @param buf the buffer
+         * @param n the number of elements
+         * @param mean the mean of the distribution
+         * @param stddev the standard deviation of the distribution
+         */
+        void fill_normal(double* buf, size_t n, double mean = 0.0, double stddev = 1.0) {
+            std::normal_distribution<> u(mean, stddev);
+            for(size_t i = 0; i < n; ++i)
+                buf[i] = u(*eng);
+        }
+        /**
+         * @brief fills a buffer with random numbers with log normal distribution. As a single distribution object is
+         * used for all elements the sequence differs from calling lognormal() n times.
+         *
+         * @param buf the buffer
+         * @param n the number of elements
+         * @param m the mean of the underlying normal distribution
+         * @param s the standard deviation of the underlying normal distribution
+         */
+        void fill_lognormal(double* buf, size_t n, double m = 0.0, double s = 1.0) {
+            std::lognormal_distribution<> u(m, s);
+            for(size_t i = 0; i < n; ++i)
+                buf[i] = u(*eng);
+        }
+        //! \brief the underlying engine e.g. to be used with other distributions
+        engine_type& engine() { return *eng; }
+
+    private:
+        friend class MT19937;
+        explicit rng_handle(engine_type& e)
+        : eng(&e) {}
+        engine_type* eng;
+    };
+    //! the handle to a Mersenne-Twister engine
+    using handle = rng_handle<std::mt19937_64>;
+    //! the handle to a xoshiro256** engine
+    using fast_handle = rng_handle<util::xoshiro256ss>;
+    /**
+     * @brief get the handle of the Mersenne-Twister engine of an object, it is the engine used by the static
+     * functions when called from within this object
+     *
+     * @param obj the object, if nullptr the current object (process) is used
+     * @return the handle
+     */
+    static handle get_handle(sc_core::sc_object* obj = nullptr);
+    /**
+     * @brief get the handle of the xoshiro256** engine of an object. The engine is seeded the same way as the
+     * Mersenne-Twister engine but yields a different sequence.
+     *
+     * @param obj the object, if nullptr the current object (process) is used
+     * @return the handle
+     */
+    static fast_handle get_fast_handle(sc_core::sc_object* obj = nullptr);
     /**
      * Seeds the mersenne twister PRNG with the given value
      *
@@ -56,6 +56,11 @@ struct observer {
      */
     struct notification_handle {
         virtual bool notify() = 0;
+        /**
+         * @brief if true the observed object calls notify() upon each change, otherwise it may defer the call to the
+         * end of the delta cycle (e.g. scc::sc_variable) and call it once for several changes
+         */
+        virtual bool push_notification() const { return false; }
         virtual ~notification_handle() {}
     };
     virtual notification_handle* observe(bool const& o, std::string const& nm) = 0;
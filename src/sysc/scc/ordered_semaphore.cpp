@@ -30,21 +30,15 @@ using namespace sc_core;
 //  The sc_semaphore primitive channel class.
 // ----------------------------------------------------------------------------
 
-// error reporting
-namespace {
-auto gen_unique_event_name(const char* modifier) -> std::string {
-    auto str = std::string("$$$$kernel_event$$$$_") + "_" + modifier;
-    return std::string(sc_core::sc_gen_unique_name(str.c_str(), false));
-}
-} // namespace
-
 void ordered_semaphore::set_capacity(unsigned c) {
     if(typeid(*this) == typeid(ordered_semaphore)) {
         auto diff = static_cast<int>(capacity) - static_cast<int>(c);
         capacity = c;
         value -= diff;
-        if(value > 0)
-            free_evt.notify(sc_core::SC_ZERO_TIME);
+        while(value > 0 && grant_next())
+            --value;
+        if(value_ref)
+            value_ref->notify();
     } else {
         SCCWARN(SCMOD) << "cannot resize fixed size ordered semaphore";
     }
@@ -64,7 +58,6 @@ void ordered_semaphore::report_error(const char* id, const char* add_msg) const
 // constructors
 ordered_semaphore::ordered_semaphore(unsigned init_value_)
 : sc_core::sc_object(sc_core::sc_gen_unique_name("semaphore"))
-, free_evt(gen_unique_event_name("free_event").c_str())
 , value(init_value_)
 , capacity(init_value_) {
     if(value < 0) {
@@ -74,7 +67,6 @@ ordered_semaphore::ordered_semaphore(unsigned init_value_)
 
 ordered_semaphore::ordered_semaphore(const char* name_, unsigned init_value_, bool value_traceable)
 : sc_object(name_)
-, free_evt(gen_unique_event_name("free_event").c_str())
 , value(init_value_)
 , capacity(init_value_)
 , value_traceable(value_traceable) {
@@ -87,22 +79,51 @@ ordered_semaphore::ordered_semaphore(const char* name_, unsigned init_value_, bo
 
 // interface methods
 
+bool ordered_semaphore::grant_next() {
+    auto& q = queue[1].head ? queue[1] : queue[0];
+    auto* w = q.head;
+    if(!w)
+        return false;
+    q.head = w->next;
+    if(!q.head)
+        q.tail = nullptr;
+    w->evt.notify(sc_core::SC_ZERO_TIME);
+    return true;
+}
+
 // lock (take) the semaphore, block if not available
 auto ordered_semaphore::wait(unsigned priority) -> int {
-    queue.at(priority).push_back(sc_core::sc_get_current_process_handle());
-    while(in_use()) {
-        sc_core::wait(free_evt);
+    auto& q = queue.at(priority);
+    if(value > 0 && !has_waiters()) {
+        --value;
+        if(value_ref)
+            value_ref->notify();
+        return value;
     }
-    --value;
-    if(value_ref)
-        value_ref->notify();
+    auto* w = free_waiters;
+    if(w)
+        free_waiters = w->next;
+    else {
+        waiter_pool.emplace_back(new waiter);
+        w = waiter_pool.back().get();
+    }
+    w->next = nullptr;
+    if(q.tail)
+        q.tail->next = w;
+    else
+        q.head = w;
+    q.tail = w;
+    // the token is handed over by post(), the value has already been accounted for
+    sc_core::wait(w->evt);
+    w->next = free_waiters;
+    free_waiters = w;
     return value;
 }
 
 // lock (take) the semaphore, return -1 if not available
 
 auto ordered_semaphore::trywait() -> int {
-    if(in_use()) {
+    if(value <= 0 || has_waiters()) {
         return -1;
     }
     --value;
@@ -114,15 +135,15 @@ auto ordered_semaphore::trywait() -> int {
 // unlock (give) the semaphore
 
 auto ordered_semaphore::post() -> int {
-    if(capacity && value == capacity) {
+    if(grant_next())
+        return value;
+    if(capacity && value == static_cast<int>(capacity)) {
         SCCWARN(SCMOD) << "post() called on entirely free semaphore!";
     } else {
         ++value;
         if(value_ref)
             value_ref->notify();
     }
-    if(value > 0)
-        free_evt.notify(sc_core::SC_ZERO_TIME);
     return value;
 }
 
@@ -19,7 +19,8 @@
 #include "sc_variable.h"
 #include "traceable.h"
 #include <array>
-#include <deque>
+#include <memory>
+#include <vector>
 #include <sysc/communication/sc_semaphore_if.h>
 #include <sysc/kernel/sc_event.h>
 #include <sysc/kernel/sc_object.h>
@@ -40,7 +41,10 @@ namespace scc {
  * @brief The ordered_semaphore primitive channel class.
  *
  * The ordered semaphore acts like an ordinary semaphore. It gives the guarantee that access is granted in the order of
- * arrival (FCFS)
+ * arrival (FCFS), waiters with priority 1 are served before waiters with priority 0.
+ *
+ * A post() hands the token directly to the next waiter. Each waiter blocks on its own event taken from a pool, hence
+ * exactly one process is woken per post.
  */
 class SC_API ordered_semaphore : public sc_core::sc_semaphore_if, public sc_core::sc_object, public scc::traceable {
 public:
@@ -180,34 +184,32 @@ public:
     };
 
 protected:
+    //! a blocked process, the nodes are recycled through a free list
+    struct waiter {
+        sc_core::sc_event evt;
+        waiter* next{nullptr};
+    };
+    //! an intrusive FIFO of waiters
+    struct waiter_list {
+        waiter* head{nullptr};
+        waiter* tail{nullptr};
+    };
     // support methods
-    bool in_use() {
-        if(value > 0) {
-            if(queue[1].size()) {
-                if(queue[1].front() == sc_core::sc_get_current_process_handle()) {
-                    queue[1].pop_front();
-                    return false;
-                }
-            } else {
-                if(queue[0].front() == sc_core::sc_get_current_process_handle()) {
-                    queue[0].pop_front();
-                    return false;
-                }
-            }
-        }
-        return true;
-    }
+    bool has_waiters() const { return queue[0].head || queue[1].head; }
+    //! hands the token to the longest waiting process of the highest priority, returns false if there is none
+    bool grant_next();
 
     // error reporting
     void report_error(const char* id, const char* add_msg = 0) const;
 
 protected:
-    sc_core::sc_event free_evt; // event to block on when m_value is negative
-    int value;                  // current value of the semaphore
+    int value; // current value of the semaphore
     unsigned capacity;
     bool value_traceable = false;
     std::unique_ptr<scc::sc_ref_variable<int>> value_ref;
-    std::array<std::deque<sc_core::sc_process_handle>, 2> queue;
+    std::array<waiter_list, 2> queue;
+    waiter* free_waiters{nullptr};
+    std::vector<std::unique_ptr<waiter>> waiter_pool;
 };
 
 template <unsigned CAPACITY> struct ordered_semaphore_t : public ordered_semaphore {
@@ -45,6 +45,32 @@ struct sc_clock_ext : public sc_core::sc_clock {
     }
 
     virtual ~sc_clock_ext() = default;
+    /**
+     * @brief the number of posedges which happened until the current simulation time (including an edge at the
+     * current time), it is computed from the clock parameters so no process needs to count edges
+     *
+     * @return the number of clock cycles
+     */
+    uint64_t cycle_count() const { return cycle_count(sc_core::sc_time_stamp()); }
+    /**
+     * @brief the number of posedges which happened until the given time (including an edge at that time)
+     *
+     * @param t the absolute simulation time
+     * @return the number of clock cycles
+     */
+    uint64_t cycle_count(sc_core::sc_time const& t) const {
+        auto const first = first_posedge();
+        return t < first ? 0 : (t - first).value() / period.get_value().value() + 1;
+    }
+    /**
+     * @brief the time of the n-th posedge, counting from 1
+     *
+     * @param n the number of the clock cycle
+     * @return the absolute simulation time of the posedge
+     */
+    sc_core::sc_time cycle_time(uint64_t n) const {
+        return n ? first_posedge() + sc_core::sc_time::from_value((n - 1) * period.get_value().value()) : sc_core::SC_ZERO_TIME;
+    }
 
 protected:
     void end_of_elaboration() override {
@@ -59,6 +85,10 @@ protected:
             }
         }
     }
+    sc_core::sc_time first_posedge() const {
+        return m_posedge_first ? initial_delay.get_value()
+                               : initial_delay.get_value() + period.get_value() * (1.0 - duty_cycle.get_value());
+    }
     void period_write_callback(const cci::cci_param_write_event<int>& ev) {}
     static inline std::string get_cci_name(const char* base, const char* name) { return std::string(base) + "_" + name; }
 };
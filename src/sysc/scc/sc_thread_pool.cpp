@@ -25,27 +25,117 @@
 namespace scc {
 
 sc_thread_pool::sc_thread_pool()
-: sc_core::sc_object(sc_core::sc_gen_unique_name("pool")) {}
+: sc_core::sc_object(sc_core::sc_gen_unique_name("pool")) {
+    if(prespawn_threads.get_value())
+        prespawn(prespawn_threads.get_value());
+}
 
 sc_thread_pool::~sc_thread_pool() = default;
 
-void sc_thread_pool::execute(std::function<void(void)> fct) {
+void sc_thread_pool::execute(task_type task, stack_class cls) {
+    auto const c = static_cast<unsigned>(cls);
+    // hand the task directly to an idle thread of the class or of a larger one
+    for(auto i = c; i < CLASSES; ++i) {
+        if(!classes[i].idle.empty()) {
+            auto* w = classes[i].idle.back();
+            classes[i].idle.pop_back();
+            w->task = std::move(task);
+            if(sc_core::sc_is_running())
+                w->wakeup.notify();
+            else
+                w->wakeup.notify(sc_core::SC_ZERO_TIME);
+            return;
+        }
+    }
+    // at the limit a thread is only spawned if none of the existing threads will ever take the task
+    if(workers.size() < max_concurrent_threads.get_value() || !can_serve(c)) {
+        spawn(c, std::move(task));
+        return;
+    }
+    classes[c].queued.push_back(std::move(task));
+    if(++queued > queued_max)
+        queued_max = queued;
+}
+
+void sc_thread_pool::prespawn(unsigned count, stack_class cls) {
+    auto const c = static_cast<unsigned>(cls);
+    for(unsigned i = 0; i < count; ++i)
+        classes[c].idle.push_back(spawn(c, task_type()));
+}
+
+sc_thread_pool::worker* sc_thread_pool::spawn(unsigned cls, task_type&& task) {
+    workers.emplace_back(new worker);
+    auto* w = workers.back().get();
+    w->cls = cls;
+    classes[cls].spawned++;
+    w->task = std::move(task);
     sc_core::sc_spawn_options opts;
-    opts.set_stack_size(0x10000);
-    if((thread_avail == 0 || dispatch_queue.has_next()) && thread_active < max_concurrent_threads.get_value())
-        sc_core::sc_spawn(
-            [this]() {
-                thread_active++;
-                while(true) {
-                    thread_avail++;
-                    auto fct = dispatch_queue.get();
-                    sc_assert(thread_avail > 0);
-                    thread_avail--;
-                    fct();
-                }
-            },
-            nullptr, &opts);
-    dispatch_queue.notify(std::move(fct));
+    // a thread without a task waits to be woken, otherwise it starts right away
+    if(!w->task) {
+        opts.dont_initialize();
+        opts.set_sensitivity(&w->wakeup);
+    }
+    switch(cls) {
+    case 0:
+        opts.set_stack_size(small_stack_size.get_value());
+        break;
+    case 2:
+        opts.set_stack_size(large_stack_size.get_value());
+        break;
+    default:
+        opts.set_stack_size(default_stack_size.get_value());
+        break;
+    }
+    sc_core::sc_spawn([this, w]() { run(w); }, sc_core::sc_gen_unique_name("pool_thread"), &opts);
+    threads_spawned.set_value(workers.size());
+    return w;
+}
+
+bool sc_thread_pool::take_queued(worker* w) {
+    // a thread serves its own class first and then the classes with smaller stacks
+    for(auto i = static_cast<int>(w->cls); i >= 0; --i) {
+        auto& q = classes[i].queued;
+        if(!q.empty()) {
+            w->task = std::move(q.front());
+            q.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool sc_thread_pool::can_serve(unsigned cls) const {
+    for(auto i = cls; i < CLASSES; ++i)
+        if(classes[i].spawned)
+            return true;
+    return false;
+}
+
+void sc_thread_pool::run(worker* w) {
+    while(true) {
+        if(!w->task && !take_queued(w)) {
+            update_stats();
+            classes[w->cls].idle.push_back(w);
+            sc_core::wait(w->wakeup);
+            continue;
+        }
+        if(++busy > busy_max)
+            busy_max = busy;
+        auto task = std::move(w->task);
+        task();
+        busy--;
+        executed++;
+    }
+}
+
+void sc_thread_pool::update_stats() {
+    if(tasks_executed.get_value() != executed)
+        tasks_executed.set_value(executed);
+    if(max_busy_threads.get_value() != busy_max)
+        max_busy_threads.set_value(busy_max);
+    if(max_queued_tasks.get_value() != queued_max)
+        max_queued_tasks.set_value(queued_max);
 }
 
 } /* namespace scc */
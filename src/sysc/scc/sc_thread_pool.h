@@ -16,10 +16,13 @@
 
 #ifndef SYSC_SCC_SC_THREAD_POOL_H_
 #define SYSC_SCC_SC_THREAD_POOL_H_
-#include "peq.h"
+#include <array>
 #include <cci_configuration>
-#include <functional>
+#include <deque>
+#include <memory>
 #include <systemc>
+#include <util/small_task.h>
+#include <vector>
 
 /** \ingroup scc-sysc
  *  @{
@@ -27,19 +30,84 @@
 /**@{*/
 //! @brief SCC SystemC utilities
 namespace scc {
-
+/**
+ * @class sc_thread_pool
+ * @brief a pool of SC_THREADs executing blocking tasks
+ *
+ * A task is handed directly to an idle thread. If there is none a new thread is spawned as long as
+ * max_concurrent_threads is not reached, otherwise the task is queued until a thread becomes available. Threads can be
+ * pre-spawned during elaboration and come in several stack size classes; a thread with a larger stack also serves
+ * tasks of smaller classes. If the limit has been reached with threads of smaller classes only, one thread of the
+ * requested class is spawned beyond the limit so that the task cannot wait forever.
+ *
+ * Tasks are move-only objects storing callables of up to 64 bytes without heap allocation (see util::small_task).
+ * The utilization statistics are exposed as CCI parameters, they are updated whenever a thread becomes idle.
+ */
 class sc_thread_pool : sc_core::sc_object {
 public:
+    //! the stack size classes of the threads
+    enum class stack_class : unsigned { SMALL = 0, DEFAULT = 1, LARGE = 2 };
+    //! the type of the tasks
+    using task_type = util::small_task;
+
     sc_thread_pool();
     virtual ~sc_thread_pool();
-
-    void execute(std::function<void(void)> fct);
+    /**
+     * @brief executes a task in a thread of the pool
+     *
+     * @param task the task
+     * @param cls the stack size class of the thread to use
+     */
+    void execute(task_type task, stack_class cls = stack_class::DEFAULT);
+    /**
+     * @brief spawns threads which wait for tasks, should be called during elaboration
+     *
+     * @param count the number of threads
+     * @param cls the stack size class of the threads
+     */
+    void prespawn(unsigned count, stack_class cls = stack_class::DEFAULT);
 
     cci::cci_param<unsigned> max_concurrent_threads{"max_concurrent_threads", 16};
 
+    cci::cci_param<unsigned> prespawn_threads{"prespawn_threads", 0, "number of threads of the default class spawned upon construction"};
+
+    cci::cci_param<unsigned> small_stack_size{"small_stack_size", 0x4000, "stack size of threads of the small class"};
+
+    cci::cci_param<unsigned> default_stack_size{"default_stack_size", 0x10000, "stack size of threads of the default class"};
+
+    cci::cci_param<unsigned> large_stack_size{"large_stack_size", 0x100000, "stack size of threads of the large class"};
+
+    cci::cci_param<uint64_t> tasks_executed{"tasks_executed", 0, "statistics: number of tasks executed"};
+
+    cci::cci_param<unsigned> threads_spawned{"threads_spawned", 0, "statistics: number of threads spawned"};
+
+    cci::cci_param<unsigned> max_busy_threads{"max_busy_threads", 0, "statistics: maximum number of concurrently busy threads"};
+
+    cci::cci_param<unsigned> max_queued_tasks{"max_queued_tasks", 0, "statistics: maximum number of tasks waiting for a thread"};
+
 private:
-    scc::peq<std::function<void(void)>> dispatch_queue{"dispatch_queue"};
-    unsigned thread_avail{0}, thread_active{0};
+    struct worker {
+        sc_core::sc_event wakeup;
+        task_type task;
+        unsigned cls;
+    };
+    struct class_state {
+        std::vector<worker*> idle;
+        std::deque<task_type> queued;
+        unsigned spawned{0};
+    };
+    static constexpr unsigned CLASSES = 3;
+
+    worker* spawn(unsigned cls, task_type&& task);
+    void run(worker* w);
+    bool take_queued(worker* w);
+    bool can_serve(unsigned cls) const;
+    void update_stats();
+
+    std::array<class_state, CLASSES> classes;
+    std::vector<std::unique_ptr<worker>> workers;
+    unsigned busy{0}, busy_max{0}, queued{0}, queued_max{0};
+    uint64_t executed{0};
 };
 } /* namespace scc */
 /** @} */ // end of scc-sysc
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
+#include "sc_variable.h"
+#include <algorithm>
+#include <systemc>
+#include <unordered_map>
+
+namespace scc {
+/**
+ * collects the changed sc_variables of a delta cycle and notifies their observers once in the next delta cycle
+ * of the same time step
+ */
+struct sc_variable_collector {
+    sc_variable_collector() {
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&evt);
+        sc_core::sc_spawn([this]() { flush(); }, sc_core::sc_gen_unique_name("sc_variable_collector"), &opts);
+    }
+
+    static sc_variable_collector& get() {
+        // the collectors are never destroyed as the kernel keeps referencing them through their processes
+        static std::unordered_map<sc_core::sc_simcontext*, sc_variable_collector*> collectors;
+        auto& c = collectors[sc_core::sc_get_curr_simcontext()];
+        if(!c)
+            c = new sc_variable_collector;
+        return *c;
+    }
+
+    void add(sc_variable_b const* v) {
+        if(changed.empty())
+            evt.notify(sc_core::SC_ZERO_TIME);
+        changed.push_back(v);
+    }
+
+    void remove(sc_variable_b const* v) { changed.erase(std::remove(changed.begin(), changed.end(), v), changed.end()); }
+
+    void flush() {
+        std::swap(changed, processing);
+        for(auto v : processing)
+            v->notify_observers();
+        processing.clear();
+    }
+
+    sc_core::sc_event evt;
+    std::vector<sc_variable_b const*> changed;
+    std::vector<sc_variable_b const*> processing;
+};
+
+sc_variable_b::~sc_variable_b() {
+    if(dirty)
+        sc_variable_collector::get().remove(this);
+}
+
+void sc_variable_b::schedule_notification() const { sc_variable_collector::get().add(this); }
+} // namespace scc
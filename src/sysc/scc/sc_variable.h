@@ -19,9 +19,14 @@
 
 #include "observer.h"
 #include "report.h"
+#include <algorithm>
 #include <array>
 #include <functional>
+#include <memory>
 #include <sstream>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 #include <sysc/kernel/sc_event.h>
 #include <sysc/kernel/sc_simcontext.h>
 #include <sysc/tracing/sc_trace.h>
@@ -70,6 +75,54 @@ struct sc_variable_b : sc_core::sc_object {
     virtual std::string to_string() const { return ""; };
 
     virtual void trace(observer* obs) const = 0;
+
+    virtual ~sc_variable_b();
+
+protected:
+    /**
+     * @brief registers an observer handle. Handles asking for push semantics are notified upon each change, all others
+     * once per delta cycle in which the value changed.
+     *
+     * @param h the handle, may be nullptr
+     */
+    void add_observer(observer::notification_handle* h) const {
+        if(!h)
+            return;
+        if(h->push_notification())
+            push_hndl.push_back(h);
+        else
+            hndl.push_back(h);
+        observed = true;
+    }
+    /**
+     * @brief marks the value as changed. If nobody observes the variable this is a single test, otherwise the
+     * variable is recorded once for the collector process.
+     */
+    void changed() const {
+        if(!observed)
+            return;
+        for(auto h : push_hndl)
+            h->notify();
+        if(!dirty && hndl.size()) {
+            dirty = true;
+            schedule_notification();
+        }
+    }
+
+private:
+    friend struct sc_variable_collector;
+    void schedule_notification() const;
+    void notify_observers() const {
+        dirty = false;
+        for(auto h : hndl)
+            h->notify();
+    }
+    //! the observer handles notified by the collector
+    mutable std::vector<observer::notification_handle*> hndl;
+    //! the observer handles notified upon each change
+    mutable std::vector<observer::notification_handle*> push_hndl;
+    mutable bool observed{false};
+    mutable bool dirty{false};
 };
 /**
  * @struct sc_variable
@@ -95,8 +148,7 @@ template <typename T> struct sc_variable : public sc_variable_b {
      */
     sc_variable(const std::string& name, const T& value)
     : sc_variable_b(name.c_str())
-    , value(value)
-    , hndl{} {}
+    , value(value) {}
 
     virtual ~sc_variable() = default;
     /**
@@ -129,8 +181,7 @@ template <typename T> struct sc_variable : public sc_variable_b {
     // assignment operator overload
     sc_variable& operator=(const T other) {
         value = other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return *this;
     }
     /**
@@ -172,8 +223,7 @@ template <typename T> struct sc_variable : public sc_variable_b {
     //! overloaded prefix ++ operator
     sc_variable& operator++() {
         ++value; // increment this object
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return *this;
     }
 
@@ -181,15 +231,13 @@ template <typename T> struct sc_variable : public sc_variable_b {
     T operator++(int) {
         auto orig = value;
         ++value;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return orig;
     }
     //! overloaded prefix -- operator
     sc_variable& operator--() {
         --value; // increment this object
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return *this;
     }
 
@@ -197,34 +245,29 @@ template <typename T> struct sc_variable : public sc_variable_b {
     T operator--(int) {
         auto orig = value;
         --value;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return orig;
     }
 
     //" arithmetic operator overloads
     T operator+=(const T other) {
         value += other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return value;
     }
     T operator-=(const T other) {
         value -= other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return value;
     }
     T operator*=(const T other) {
         value *= other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return value;
     }
     T operator/=(const T other) {
         value /= other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return value;
     }
     T operator+(const T other) const { return value - other; }
@@ -243,12 +286,12 @@ template <typename T> struct sc_variable : public sc_variable_b {
      */
     void trace(sc_core::sc_trace_file* tf) const override {
         if(auto* obs = dynamic_cast<observer*>(tf))
-            hndl.push_back(observe(obs, value, name()));
+            add_observer(observe(obs, value, name()));
         else
             sc_core::sc_trace(tf, value, name());
     }
 
-    void trace(observer* obs) const override { hndl.push_back(observe(obs, value, name())); }
+    void trace(observer* obs) const override { add_observer(observe(obs, value, name())); }
 
     static sc_variable<T> create(const char* n, size_t i, T default_val) {
         std::ostringstream os;
@@ -268,8 +311,6 @@ template <typename T> struct sc_variable : public sc_variable_b {
 private:
     //! the wrapped value
     T value;
-    //! the observer handle
-    mutable std::vector<observer::notification_handle*> hndl;
 };
 
 template <typename T> T operator+(sc_variable<T> const& a, sc_variable<T> const& b) { return a.get() + b.get(); }
@@ -288,8 +329,7 @@ template <> struct sc_variable<bool> : public sc_variable_b {
     const bool& operator*() { return value; }
     sc_variable(const std::string& name, const bool& value)
     : sc_variable_b(name.c_str())
-    , value(value)
-    , hndl{} {}
+    , value(value) {}
     virtual ~sc_variable() = default;
     std::string to_string() const override {
         std::stringstream ss;
@@ -300,19 +340,18 @@ template <> struct sc_variable<bool> : public sc_variable_b {
     operator bool() const { return value; }
     sc_variable& operator=(const bool other) {
         value = other;
-        for(auto h : hndl)
-            h->notify();
+        changed();
         return *this;
     }
     bool operator==(bool other) const { return value == other; }
     bool operator!=(bool other) const { return value != other; }
     void trace(sc_core::sc_trace_file* tf) const override {
         if(auto* obs = dynamic_cast<observer*>(tf))
-            hndl.push_back(observe(obs, value, name()));
+            add_observer(observe(obs, value, name()));
         else
             sc_core::sc_trace(tf, value, name());
     }
-    void trace(observer* obs) const override { hndl.push_back(observe(obs, value, name())); }
+    void trace(observer* obs) const override { add_observer(observe(obs, value, name())); }
     static scc::sc_variable<bool> create(const char* n, size_t i, bool default_val) {
         std::ostringstream os;
         os << n << "[" << i << "];";
@@ -330,12 +369,14 @@ template <> struct sc_variable<bool> : public sc_variable_b {
 
 private:
     bool value;
-    mutable std::vector<observer::notification_handle*> hndl;
 };
 /**
  * a vector holding sc_variable. It can be used as a sparse array by providing a creator function or
  * as a normal vector when providing a default value upon creating or resizing
  *
+ * Elements created with a default value are constructed in place in contiguous blocks of storage, one block per
+ * resize, instead of being allocated one by one.
+ *
  * @note after end of elaboration the size of the vector cannot be change. It is also not possible to
  * add elements e.g. when using as a sparse array.
  *
@@ -359,21 +400,35 @@ template <typename T> struct sc_variable_vector {
     , values(size, nullptr)
     , creator(creator) {}
 
+    sc_variable_vector(sc_variable_vector const&) = delete;
+    sc_variable_vector& operator=(sc_variable_vector const&) = delete;
+
     size_t size() { return values.size(); }
 
     void resize(size_t sz) {
         assert(!sc_core::sc_get_curr_simcontext()->elaboration_done());
-        values.resize(sz);
+        shrink(sz);
+        values.resize(sz, nullptr);
     }
 
     void resize(size_t sz, T def_val) {
         assert(!sc_core::sc_get_curr_simcontext()->elaboration_done());
-        values.resize(sz);
+        shrink(sz);
+        values.resize(sz, nullptr);
+        auto missing = std::count(values.begin(), values.end(), nullptr);
+        if(!missing)
+            return;
+        blocks.emplace_back(new storage_type[missing]);
+        auto* mem = blocks.back().get();
         auto idx = 0U;
         for(auto& e : values) {
-            std::stringstream ss;
-            ss << name << "(" << idx++ << ")";
-            e = new sc_variable<T>(ss.str().c_str(), def_val);
+            if(!e) {
+                std::stringstream ss;
+                ss << name << "(" << idx << ")";
+                e = new(mem++) sc_variable<T>(ss.str().c_str(), def_val);
+                in_place.insert(e);
+            }
+            ++idx;
         }
     }
 
@@ -398,15 +453,34 @@ template <typename T> struct sc_variable_vector {
         assert(values.at(idx) && "No initialized value in sc_variable_vector position");
         return *values.at(idx);
     }
-    ~sc_variable_vector() {
-        for(auto p : values)
+    ~sc_variable_vector() { shrink(0); }
+
+private:
+    using storage_type = typename std::aligned_storage<sizeof(sc_variable<T>), alignof(sc_variable<T>)>::type;
+
+    void shrink(size_t sz) {
+        for(auto i = sz; i < values.size(); ++i)
+            release(values[i]);
+        if(sz < values.size())
+            values.resize(sz);
+    }
+
+    void release(sc_variable<T>* p) {
+        if(!p)
+            return;
+        auto it = in_place.find(p);
+        if(it != in_place.end()) {
+            p->~sc_variable<T>();
+            in_place.erase(it);
+        } else
             delete p;
     }
 
-private:
     std::string name{};
     std::vector<sc_variable<T>*> values;
     std::function<sc_variable<T>*(char const*, size_t)> creator;
+    std::vector<std::unique_ptr<storage_type[]>> blocks;
+    std::unordered_set<sc_variable<T> const*> in_place;
 };
 /**
  * @struct sc_ref_variable
@@ -459,23 +533,18 @@ template <typename T> struct sc_ref_variable : public sc_variable_b {
     void trace(sc_core::sc_trace_file* tf) const override {
         if(active_notification)
             if(auto* obs = dynamic_cast<observer*>(tf)) {
-                hndl.push_back(observe(obs, value, name()));
+                add_observer(observe(obs, value, name()));
                 return;
             }
         sc_core::sc_trace(tf, value, name());
     }
 
-    void trace(observer* obs) const override { hndl.push_back(observe(obs, value, name())); }
+    void trace(observer* obs) const override { add_observer(observe(obs, value, name())); }
 
-    void notify() const {
-        for(auto h : hndl)
-            h->notify();
-    }
+    void notify() const { changed(); }
 
 private:
     const bool active_notification;
-    //! the observer handle
-    mutable std::vector<observer::notification_handle*> hndl;
 };
 template <> struct sc_ref_variable<sc_core::sc_event> : public sc_variable_b {
     const sc_core::sc_event& value;
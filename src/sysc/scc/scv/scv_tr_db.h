@@ -16,6 +16,7 @@
 
 #ifndef _SCC_SCV_TR_DB_H_
 #define _SCC_SCV_TR_DB_H_
+#include <string>
 #ifndef HAS_SCV
 namespace scv_tr {
 #endif
@@ -50,6 +51,29 @@ void scv_tr_plain_init();
  *
  */
 void scv_tr_lz4_init();
+/**
+ * @fn void scv_tr_lz4_sharded_init(unsigned)
+ * @brief initializes the infrastructure to use a set of LZ4 compressed text based transaction recording databases
+ *
+ * Each stream is assigned to one shard and each shard is written by its own background thread. The shards are listed
+ * in an index file named <db name>.txidx and can be combined using scv_tr_lz4_merge_shards().
+ *
+ * @param shards the number of shards, 0 means one per hardware thread
+ */
+void scv_tr_lz4_sharded_init(unsigned shards);
+/**
+ * @fn bool scv_tr_lz4_merge_shards(std::string const&, std::string const&)
+ * @brief merges the shards listed in an index file into a single LZ4 compressed text based database ordered by time
+ *
+ * As transactions may be recorded with a delay the records of each shard are loaded and sorted by time before being
+ * merged, hence the memory needed is in the order of the uncompressed size of the database. The command line
+ * tool scv_tr_merge provides this function.
+ *
+ * @param index_name the name of the index file (<db name>.txidx)
+ * @param out_name the name of the resulting database
+ * @return true if all shards could be read and the result written
+ */
+bool scv_tr_lz4_merge_shards(std::string const& index_name, std::string const& out_name);
 /**
  * @fn void scv_tr_mtc_init()
  * @brief initializes the infrastructure to use a compressed text based transaction recording database with a
@@ -27,6 +27,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/interned_names.h>
 #include <vector>
 // clang-format off
 #ifdef HAS_SCV
@@ -114,23 +115,16 @@ template <bool COMPRESSED> struct tx_db {
             }
     }
     // ----------------------------------------------------------------------------
-    static inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-        string name{prefix};
-        if(!prefix || strlen(prefix) == 0) {
-            name = my_exts_p->get_name();
-        } else {
-            if((my_exts_p->get_name() != nullptr) && (strlen(my_exts_p->get_name()) > 0)) {
-                name += ".";
-                name += my_exts_p->get_name();
-            }
-        }
-        return (name == "") ? "<unnamed>" : name;
-    }
+    // attribute names are kept as paths in the shared string interner, see util/interned_names.h
+    using util::interned_names::path_id;
+    using util::interned_names::intern_prefix;
+    using util::interned_names::generator_prefix;
+    using util::interned_names::get_name;
     // ----------------------------------------------------------------------------
-    static void recordAttributes(uint64_t id, event_type eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
+    static void recordAttributes(uint64_t id, event_type eventType, path_id prefix, const scv_extensions_if* my_exts_p) {
         if(!db || my_exts_p == nullptr)
             return;
-        auto name = get_name(prefix, my_exts_p);
+        auto const& name = get_name(prefix, my_exts_p);
         switch(my_exts_p->get_type()) {
         case scv_extensions_if::RECORD: {
             int num_fields = my_exts_p->get_num_fields();
@@ -209,22 +203,15 @@ template <bool COMPRESSED> struct tx_db {
             auto my_exts_p = t.get_begin_exts_p();
             if(my_exts_p == nullptr)
                 my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-            if(my_exts_p) {
-                auto tmp_str = t.get_scv_tr_generator_base().get_begin_attribute_name()
-                                   ? t.get_scv_tr_generator_base().get_begin_attribute_name()
-                                   : "";
-                recordAttributes(id, event_type::BEGIN, tmp_str, my_exts_p);
-            }
+            if(my_exts_p)
+                recordAttributes(id, event_type::BEGIN, generator_prefix(t.get_scv_tr_generator_base(), false), my_exts_p);
         } break;
         case scv_tr_handle::END: {
             auto my_exts_p = t.get_end_exts_p();
             if(my_exts_p == nullptr)
                 my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-            if(my_exts_p) {
-                auto tmp_str =
-                    t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-                recordAttributes(id, event_type::END, tmp_str, my_exts_p);
-            }
+            if(my_exts_p)
+                recordAttributes(id, event_type::END, generator_prefix(t.get_scv_tr_generator_base(), true), my_exts_p);
             db->endTransaction(id, t.get_end_sc_time() / sc_core::sc_time(1, sc_core::SC_PS));
         } break;
         default:;
@@ -234,7 +221,7 @@ template <bool COMPRESSED> struct tx_db {
     static void attributeCb(const scv_tr_handle& t, const char* name, const scv_extensions_if* ext, void* data) {
         if(!db || !t.get_scv_tr_stream().get_scv_tr_db() || !t.get_scv_tr_stream().get_scv_tr_db()->get_recording())
             return;
-        recordAttributes(t.get_id(), event_type::RECORD, name == nullptr ? "" : name, ext);
+        recordAttributes(t.get_id(), event_type::RECORD, intern_prefix(name), ext);
     }
     // ----------------------------------------------------------------------------
     static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
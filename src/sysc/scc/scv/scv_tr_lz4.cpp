@@ -13,21 +13,29 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *******************************************************************************/
+#include <algorithm>
 #include <array>
 #include <boost/filesystem.hpp>
 #include <cmath>
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <fcntl.h>
 #include <fmt/format.h>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <queue>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <util/interned_names.h>
 #include <util/lz4_streambuf.h>
+#include <util/string_interner.h>
 #include <vector>
 // clang-format off
 #ifdef HAS_SCV
@@ -101,6 +109,122 @@ public:
 
     bool is_open() { return ofs.is_open(); }
 };
+/*
+ * a writer which hands the formatted text in chunks over to a dedicated thread doing the LZ4 compression and the
+ * file output. This way the simulation thread only formats the text. If the thread falls behind the simulation
+ * thread blocks once max_queued_chunks are waiting so that the memory used stays bounded.
+ */
+class ShardWriter {
+    class async_streambuf : public std::streambuf {
+        static constexpr size_t chunk_size = 64 * 1024;
+        static constexpr size_t max_queued_chunks = 64;
+        std::ofstream ofs;
+        std::unique_ptr<util::lz4c_steambuf> strbuf;
+        std::ostream sink;
+        std::vector<char> buffer;
+        std::deque<std::vector<char>> queue;
+        std::vector<std::vector<char>> free_buffers;
+        std::mutex mtx;
+        std::condition_variable cond;
+        std::condition_variable drained;
+        bool done{false};
+        std::thread worker;
+
+        void run() {
+            std::vector<char> chunk;
+            std::unique_lock<std::mutex> lock(mtx);
+            while(true) {
+                cond.wait(lock, [this]() -> bool { return done || !queue.empty(); });
+                if(queue.empty())
+                    break;
+                chunk.swap(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                drained.notify_one();
+                sink.write(chunk.data(), chunk.size());
+                chunk.clear();
+                lock.lock();
+                free_buffers.emplace_back(std::move(chunk));
+            }
+        }
+
+        void hand_over() {
+            if(pptr() == pbase())
+                return;
+            buffer.resize(pptr() - pbase());
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                drained.wait(lock, [this]() -> bool { return queue.size() < max_queued_chunks; });
+                queue.emplace_back(std::move(buffer));
+                if(free_buffers.size()) {
+                    buffer = std::move(free_buffers.back());
+                    free_buffers.pop_back();
+                } else
+                    buffer = std::vector<char>();
+            }
+            cond.notify_one();
+            buffer.resize(chunk_size);
+            setp(buffer.data(), buffer.data() + buffer.size());
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            hand_over();
+            if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            hand_over();
+            return 0;
+        }
+
+    public:
+        async_streambuf(std::string const& name)
+        : ofs(name, std::ios::binary | std::ios::trunc)
+        , strbuf(new util::lz4c_steambuf(ofs, 8192))
+        , sink(strbuf.get())
+        , buffer(chunk_size) {
+            setp(buffer.data(), buffer.data() + buffer.size());
+            worker = std::thread([this]() { run(); });
+        }
+
+        ~async_streambuf() { close(); }
+
+        void close() {
+            if(!worker.joinable())
+                return;
+            hand_over();
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                done = true;
+            }
+            cond.notify_one();
+            worker.join();
+            strbuf->close();
+            ofs.close();
+        }
+
+        bool is_open() { return ofs.is_open(); }
+    };
+    async_streambuf strbuf;
+
+public:
+    std::ostream out;
+    ShardWriter(const std::string& name)
+    : strbuf(name)
+    , out(&strbuf) {}
+
+    ~ShardWriter() {
+        out.flush();
+        strbuf.close();
+    }
+
+    bool is_open() { return strbuf.is_open(); }
+};
 
 template <typename WRITER> struct Formatter {
     std::unique_ptr<WRITER> writer;
@@ -116,6 +240,8 @@ template <typename WRITER> struct Formatter {
 
     inline void close() { delete writer.release(); }
 
+    inline void select(uint64_t) {}
+
     inline void writeStream(uint64_t id, std::string const& name, std::string const& kind) {
         auto buf = fmt::format("scv_tr_stream (ID {}, name \"{}\", kind \"{}\")\n", id, name.c_str(), kind.c_str());
         writer->out.write(buf.c_str(), buf.size());
@@ -190,6 +316,68 @@ template <typename WRITER> struct Formatter {
         return db;
     }
 };
+/*
+ * a database consisting of several shards. Each stream is mapped onto one shard which contains the stream, its
+ * generators, transactions, and the relations starting at its transactions. Each shard is a self-contained text
+ * database written by its own thread. An index file lists all shards of a database.
+ */
+struct ShardedFormatter {
+    using shard_type = Formatter<ShardWriter>;
+    static unsigned num_shards;
+    std::vector<std::unique_ptr<shard_type>> shards;
+    shard_type* current{nullptr};
+
+    static std::string shard_name(std::string const& base, unsigned idx) { return fmt::format("{}.{}.txlog", base, idx); }
+
+    static std::string base_name(std::string const& name) {
+        auto pos = name.rfind(".txlog");
+        return pos != std::string::npos && pos == name.size() - 6 ? name.substr(0, pos) : name;
+    }
+
+    inline bool open(const std::string& name) {
+        auto base = base_name(name);
+        auto count = num_shards ? num_shards : std::max(1U, std::thread::hardware_concurrency());
+        std::ofstream idx(base + ".txidx");
+        idx << "scv_tr_shards " << count << "\n";
+        shards.clear();
+        for(auto i = 0U; i < count; ++i) {
+            auto fname = shard_name(base, i);
+            shards.emplace_back(new shard_type(fname));
+            idx << "shard " << i << " \"" << boost::filesystem::path(fname).filename().string() << "\"\n";
+        }
+        current = shards.front().get();
+        return idx.good();
+    }
+
+    inline void close() {
+        shards.clear();
+        current = nullptr;
+    }
+
+    inline void select(uint64_t stream_id) { current = shards[stream_id % shards.size()].get(); }
+
+    inline void writeStream(uint64_t id, std::string const& name, std::string const& kind) { current->writeStream(id, name, kind); }
+
+    inline void writeGenerator(uint64_t id, std::string const& name, uint64_t stream, std::vector<AttrDesc> const& attributes) {
+        current->writeGenerator(id, name, stream, attributes);
+    }
+
+    inline void writeTransaction(uint64_t id, uint64_t generator, EventType type, uint64_t time) {
+        current->writeTransaction(id, generator, type, time);
+    }
+
+    template <typename T> inline void writeAttribute(uint64_t id, EventType event, const string& name, data_type type, T value) {
+        current->writeAttribute(id, event, name, type, value);
+    }
+
+    inline void writeRelation(const std::string& name, uint64_t sink_id, uint64_t src_id) { current->writeRelation(name, sink_id, src_id); }
+
+    static ShardedFormatter& get() {
+        static ShardedFormatter db;
+        return db;
+    }
+};
+unsigned ShardedFormatter::num_shards{0};
 template <typename DB> void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callback_reason reason, void* data) {
     // This is called from the scv_tr_db ctor.
     static string fName("DEFAULT_scv_tr_sqlite");
@@ -218,6 +406,7 @@ template <typename DB> void dbCb(const scv_tr_db& _scv_tr_db, scv_tr_db::callbac
 template <typename DB> void streamCb(const scv_tr_stream& s, scv_tr_stream::callback_reason reason, void* data) {
     if(reason == scv_tr_stream::CREATE) {
         try {
+            DB::get().select(s.get_id());
             DB::get().writeStream(s.get_id(), s.get_name(), s.get_stream_kind());
         } catch(std::runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create stream");
@@ -233,26 +422,18 @@ template <typename DB> inline void recordAttribute(uint64_t id, EventType event,
     }
 }
 // ----------------------------------------------------------------------------
-inline std::string get_name(const char* prefix, const scv_extensions_if* my_exts_p) {
-    string name;
-    if(!prefix || strlen(prefix) == 0) {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = fmt::format("{}.{}", prefix, my_exts_p->get_name());
-        }
-    }
-    return (name == "") ? "<unnamed>" : name;
-}
+// attribute names are kept as paths in the shared string interner, see util/interned_names.h
+using util::interned_names::path_id;
+using util::interned_names::intern_prefix;
+using util::interned_names::generator_prefix;
+using util::interned_names::get_name;
 
 // ----------------------------------------------------------------------------
 template <typename DB>
-inline void recordAttributes(uint64_t id, EventType eventType, char const* prefix, const scv_extensions_if* my_exts_p) {
+inline void recordAttributes(uint64_t id, EventType eventType, path_id prefix, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    auto name = get_name(prefix, my_exts_p);
+    auto const& name = get_name(prefix, my_exts_p);
     switch(my_exts_p->get_type()) {
     case scv_extensions_if::RECORD: {
         int num_fields = my_exts_p->get_num_fields();
@@ -265,9 +446,11 @@ inline void recordAttributes(uint64_t id, EventType eventType, char const* prefi
     } break;
     case scv_extensions_if::POINTER:
         if(auto ptr = my_exts_p->get_pointer()) {
-            std::stringstream ss;
-            ss << prefix << "*";
-            recordAttributes<DB>(id, eventType, ss.str().c_str(), ptr);
+            auto& interner = util::string_interner::get();
+            auto deref = prefix == util::string_interner::npos
+                             ? interner.intern_child(prefix, "*")
+                             : interner.intern_child(interner.parent(prefix), interner.str(interner.leaf(prefix)) + "*");
+            recordAttributes<DB>(id, eventType, deref, ptr);
         }
         break;
     case scv_extensions_if::ENUMERATION:
@@ -326,6 +509,7 @@ template <typename DB> void generatorCb(const scv_tr_generator_base& g, scv_tr_g
             if(my_end_exts_p != nullptr) {
                 attrs.emplace_back(END, my_end_exts_p->get_type(), g.get_end_attribute_name() ? g.get_end_attribute_name() : "");
             }
+            DB::get().select(g.get_scv_tr_stream().get_id());
             DB::get().writeGenerator(g.get_id(), g.get_name(), g.get_scv_tr_stream().get_id(), attrs);
         } catch(std::runtime_error& e) {
             _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create generator entry");
@@ -342,28 +526,23 @@ template <typename DB> void transactionCb(const scv_tr_handle& t, scv_tr_handle:
     uint64_t id = t.get_id();
     vector<uint64_t>::size_type concurrencyIdx;
     const scv_extensions_if* my_exts_p;
+    DB::get().select(t.get_scv_tr_stream().get_id());
     switch(reason) {
     case scv_tr_handle::BEGIN: {
         DB::get().writeTransaction(t.get_id(), t.get_scv_tr_generator_base().get_id(), BEGIN, t.get_begin_sc_time().value());
         my_exts_p = t.get_begin_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-            recordAttributes<DB>(id, BEGIN, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes<DB>(id, BEGIN, generator_prefix(t.get_scv_tr_generator_base(), false), my_exts_p);
     } break;
     case scv_tr_handle::END: {
-        DB::get().writeTransaction(t.get_id(), t.get_scv_tr_generator_base().get_id(), END, t.get_begin_sc_time().value());
+        DB::get().writeTransaction(t.get_id(), t.get_scv_tr_generator_base().get_id(), END, t.get_end_sc_time().value());
         my_exts_p = t.get_end_exts_p();
         if(my_exts_p == nullptr)
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
-        if(my_exts_p) {
-            auto tmp_str =
-                t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-            recordAttributes<DB>(t.get_id(), END, tmp_str, my_exts_p);
-        }
+        if(my_exts_p)
+            recordAttributes<DB>(t.get_id(), END, generator_prefix(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     default:;
     }
@@ -374,7 +553,8 @@ template <typename DB> void attributeCb(const scv_tr_handle& t, const char* name
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    recordAttributes<DB>(t.get_id(), RECORD, name == nullptr ? "" : name, ext);
+    DB::get().select(t.get_scv_tr_stream().get_id());
+    recordAttributes<DB>(t.get_id(), RECORD, intern_prefix(name), ext);
 }
 // ----------------------------------------------------------------------------
 template <typename DB>
@@ -384,13 +564,137 @@ void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data
     if(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
     try {
+        DB::get().select(tr_1.get_scv_tr_stream().get_id());
         DB::get().writeRelation(tr_1.get_scv_tr_stream().get_scv_tr_db()->get_relation_name(relation_handle), tr_1.get_id(), tr_2.get_id());
     } catch(std::runtime_error& e) {
         _scv_message::message(_scv_message::TRANSACTION_RECORDING_INTERNAL, "Can't create transaction relation");
     }
 }
+// ----------------------------------------------------------------------------
+/*
+ * reads a shard and provides its records ordered by time. A record is a line and its continuation lines (attribute
+ * values of a transaction or attribute declarations of a generator). Transactions recorded with a delay (e.g. the
+ * error window of tx_recording_policy) are written after later ones, hence all records of the shard are loaded and
+ * sorted. Definitions are placed at time 0, attributes and relations at the time of the transaction they refer to.
+ */
+struct ShardReader {
+    struct entry {
+        uint64_t time;
+        unsigned prio;
+        size_t offset, length;
+    };
+    std::ifstream ifs;
+    std::string data;
+    std::vector<entry> entries;
+    size_t pos{0};
+    uint64_t time{0};
+    unsigned prio{0};
+    char const* record{nullptr};
+    size_t record_length{0};
+
+    ShardReader(std::string const& name)
+    : ifs(name, std::ios::binary) {}
+
+    static bool is_continuation(std::string const& line) {
+        return line.compare(0, 2, "a ") == 0 || line.compare(0, 15, "begin_attribute") == 0 || line.compare(0, 13, "end_attribute") == 0 ||
+               line == ")";
+    }
+
+    bool load() {
+        util::lz4d_streambuf strbuf(ifs, 8192);
+        std::istream in(&strbuf);
+        std::unordered_map<uint64_t, uint64_t> open_tx;
+        uint64_t max_time{0};
+        std::string line, tag;
+        while(std::getline(in, line)) {
+            if(entries.size() && is_continuation(line)) {
+                data.append(line).append(1, '\n');
+                entries.back().length += line.size() + 1;
+                continue;
+            }
+            entry e{max_time, 2, data.size(), line.size() + 1};
+            std::istringstream iss(line);
+            if(line.compare(0, 9, "tx_begin ") == 0 || line.compare(0, 7, "tx_end ") == 0) {
+                uint64_t id, gen;
+                iss >> tag >> id >> gen >> e.time;
+                if(line[3] == 'b') {
+                    e.prio = 1;
+                    open_tx[id] = e.time;
+                } else
+                    open_tx.erase(id);
+                max_time = std::max(max_time, e.time);
+            } else if(line.compare(0, 20, "tx_record_attribute ") == 0) {
+                uint64_t id;
+                iss >> tag >> id;
+                auto it = open_tx.find(id);
+                if(it != open_tx.end())
+                    e.time = it->second;
+            } else if(line.compare(0, 6, "scv_tr") == 0) {
+                e.time = 0;
+                e.prio = 0;
+            }
+            data.append(line).append(1, '\n');
+            entries.push_back(e);
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](entry const& a, entry const& b) { return a.time < b.time || (a.time == b.time && a.prio < b.prio); });
+        return !in.bad();
+    }
+
+    bool next() {
+        if(pos == entries.size())
+            return false;
+        auto const& e = entries[pos++];
+        time = e.time;
+        prio = e.prio;
+        record = data.data() + e.offset;
+        record_length = e.length;
+        return true;
+    }
+};
 } // namespace
 // ----------------------------------------------------------------------------
+bool scv_tr_lz4_merge_shards(std::string const& index_name, std::string const& out_name) {
+    std::ifstream idx(index_name);
+    std::string tag;
+    unsigned count{0};
+    if(!(idx >> tag >> count) || tag != "scv_tr_shards")
+        return false;
+    auto dir = boost::filesystem::path(index_name).parent_path();
+    std::vector<std::unique_ptr<ShardReader>> readers;
+    std::string line;
+    std::getline(idx, line);
+    while(std::getline(idx, line)) {
+        auto start = line.find('"');
+        auto end = line.rfind('"');
+        if(start == std::string::npos || end <= start)
+            continue;
+        auto fname = (dir / line.substr(start + 1, end - start - 1)).string();
+        readers.emplace_back(new ShardReader(fname));
+        if(!readers.back()->ifs.is_open() || !readers.back()->load())
+            return false;
+    }
+    if(readers.size() != count)
+        return false;
+    LZ4Writer writer(out_name);
+    if(!writer.is_open())
+        return false;
+    // merge the records of all shards ordered by time, definitions and transaction starts first
+    auto cmp = [](ShardReader* a, ShardReader* b) { return a->time > b->time || (a->time == b->time && a->prio > b->prio); };
+    std::priority_queue<ShardReader*, std::vector<ShardReader*>, decltype(cmp)> queue(cmp);
+    for(auto& r : readers)
+        if(r->next())
+            queue.push(r.get());
+    while(!queue.empty()) {
+        auto* r = queue.top();
+        queue.pop();
+        writer.out.write(r->record, r->record_length);
+        if(r->next())
+            queue.push(r);
+    }
+    return true;
+}
+// ----------------------------------------------------------------------------
 void scv_tr_lz4_init() {
     scv_tr_db::register_class_cb(dbCb<Formatter<LZ4Writer>>);
     scv_tr_stream::register_class_cb(streamCb<Formatter<LZ4Writer>>);
@@ -399,6 +703,15 @@ void scv_tr_lz4_init() {
     scv_tr_handle::register_record_attribute_cb(attributeCb<Formatter<LZ4Writer>>);
     scv_tr_handle::register_relation_cb(relationCb<Formatter<LZ4Writer>>);
 }
+void scv_tr_lz4_sharded_init(unsigned shards) {
+    ShardedFormatter::num_shards = shards;
+    scv_tr_db::register_class_cb(dbCb<ShardedFormatter>);
+    scv_tr_stream::register_class_cb(streamCb<ShardedFormatter>);
+    scv_tr_generator_base::register_class_cb(generatorCb<ShardedFormatter>);
+    scv_tr_handle::register_class_cb(transactionCb<ShardedFormatter>);
+    scv_tr_handle::register_record_attribute_cb(attributeCb<ShardedFormatter>);
+    scv_tr_handle::register_relation_cb(relationCb<ShardedFormatter>);
+}
 void scv_tr_plain_init() {
     scv_tr_db::register_class_cb(dbCb<Formatter<PlainWriter>>);
     scv_tr_stream::register_class_cb(streamCb<Formatter<PlainWriter>>);
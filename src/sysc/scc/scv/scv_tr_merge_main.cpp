@@ -0,0 +1,39 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+/*
+ * merges the shards of a database written by the SHARDED tracer type into a single LZ4 compressed text database:
+ *
+ *     scv_tr_merge <db name>.txidx <output>.txlog
+ */
+#include "scv_tr_db.h"
+#include <iostream>
+#include <systemc>
+
+#ifndef HAS_SCV
+using namespace scv_tr;
+#endif
+
+int sc_main(int argc, char* argv[]) {
+    if(argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <index file> <output file>\n";
+        return 2;
+    }
+    if(!scv_tr_lz4_merge_shards(argv[1], argv[2])) {
+        std::cerr << "could not merge the shards listed in " << argv[1] << " into " << argv[2] << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -21,6 +21,7 @@
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <util/interned_names.h>
 #include <vector>
 #ifdef HAS_SCV
 #include <scv.h>
@@ -297,21 +298,16 @@ inline void recordAttribute(uint64_t id, EventType event, const string& name, da
     recordAttribute(id, event, name, type, std::to_string(value));
 }
 // ----------------------------------------------------------------------------
-static void recordAttributes(uint64_t id, EventType eventType, string& prefix, const scv_extensions_if* my_exts_p) {
+// attribute names are kept as paths in the shared string interner, see util/interned_names.h
+using util::interned_names::path_id;
+using util::interned_names::intern_prefix;
+using util::interned_names::generator_prefix;
+using util::interned_names::get_name;
+// ----------------------------------------------------------------------------
+static void recordAttributes(uint64_t id, EventType eventType, path_id prefix, const scv_extensions_if* my_exts_p) {
     if(my_exts_p == nullptr)
         return;
-    string name;
-    if(prefix == "") {
-        name = my_exts_p->get_name();
-    } else {
-        if((my_exts_p->get_name() == nullptr) || (strlen(my_exts_p->get_name()) == 0)) {
-            name = prefix;
-        } else {
-            name = prefix + "." + my_exts_p->get_name();
-        }
-    }
-    if(name == "")
-        name = "<unnamed>";
+    auto const& name = get_name(prefix, my_exts_p);
     switch(my_exts_p->get_type()) {
     case scv_extensions_if::RECORD: {
         int num_fields = my_exts_p->get_num_fields();
@@ -429,9 +425,7 @@ static void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_begin_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_begin_attribute_name() ? t.get_scv_tr_generator_base().get_begin_attribute_name() : "";
-        recordAttributes(id, BEGIN, tmp_str, my_exts_p);
+        recordAttributes(id, BEGIN, generator_prefix(t.get_scv_tr_generator_base(), false), my_exts_p);
     } break;
     case scv_tr_handle::END: {
         try {
@@ -456,9 +450,7 @@ static void transactionCb(const scv_tr_handle& t, scv_tr_handle::callback_reason
         if(my_exts_p == nullptr) {
             my_exts_p = t.get_scv_tr_generator_base().get_end_exts_p();
         }
-        string tmp_str =
-            t.get_scv_tr_generator_base().get_end_attribute_name() ? t.get_scv_tr_generator_base().get_end_attribute_name() : "";
-        recordAttributes(t.get_id(), END, tmp_str, my_exts_p);
+        recordAttributes(t.get_id(), END, generator_prefix(t.get_scv_tr_generator_base(), true), my_exts_p);
     } break;
     default:;
     }
@@ -471,8 +463,7 @@ static void attributeCb(const scv_tr_handle& t, const char* name, const scv_exte
         return;
     if(t.get_scv_tr_stream().get_scv_tr_db()->get_recording() == false)
         return;
-    string tmp_str(name == nullptr ? "" : name);
-    recordAttributes(t.get_id(), RECORD, tmp_str, ext);
+    recordAttributes(t.get_id(), RECORD, intern_prefix(name), ext);
 }
 // ----------------------------------------------------------------------------
 static void relationCb(const scv_tr_handle& tr_1, const scv_tr_handle& tr_2, void* data, scv_tr_relation_handle_t relation_handle) {
@@ -32,9 +32,11 @@
 //! @brief SCC SystemC utilities
 namespace scc {
 /**
- * @struct time2tick
- * @brief translate a tick-less clock (sc_time based) to boolean clock
+ * @struct tick2time
+ * @brief translate a boolean clock to a tick-less clock (sc_time based)
  *
+ * If the input is bound to an sc_clock its period is used directly. Otherwise the period is measured between
+ * consecutive posedges and the output is only written when the measured period changes.
  */
 struct tick2time : public sc_core::sc_module
 #ifdef CWR_SYSTEMC
@@ -59,6 +61,7 @@ protected:
 private:
     sc_core::sc_time clk_period;
     sc_core::sc_time last_tick;
+    bool ticked{false};
 #ifdef CWR_SYSTEMC
     void handle_clock_parameters_updated(scml_clock_if* clk_if);
     void handle_clock_deleted(scml_clock_if*) override;
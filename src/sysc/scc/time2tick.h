@@ -17,6 +17,7 @@
 #ifndef _SCC_TIME2TICK_H_
 #define _SCC_TIME2TICK_H_
 
+#include "signal_opt_ports.h"
 #include "utilities.h"
 
 /** \ingroup scc-sysc
@@ -29,12 +30,16 @@ namespace scc {
  * @struct time2tick
  * @brief translate a tick-less clock (sc_time based) to boolean clock
  *
+ * The clock is generated by a method process which is only activated at clock edges and upon changes of the period or
+ * the gate. A period of zero or a low gate input stops the clock, the output is held low then.
  */
 struct time2tick : public sc_core::sc_module {
     //! yes, we have processes
     SC_HAS_PROCESS(time2tick); // NOLINT
     //! the clock input
     sc_core::sc_in<sc_core::sc_time> clk_i{"clk_i"};
+    //! the optional clock gate, the clock output only toggles while it is high
+    scc::sc_in_opt<bool> gate_i{"gate_i"};
     //! the clock output
     sc_core::sc_out<bool> clk_o{"clk_o"};
     /**
@@ -44,11 +49,17 @@ struct time2tick : public sc_core::sc_module {
      */
     explicit time2tick(sc_core::sc_module_name nm)
     : sc_core::sc_module(nm) {
-        SC_THREAD(clocker);
+        SC_METHOD(clocker);
     }
 
+protected:
+    void end_of_elaboration() override;
+
 private:
-    sc_core::sc_time clk_period;
+    sc_core::sc_event_or_list wake_evts;
+    sc_core::sc_time next_edge;
+    bool running{false};
+    bool level{false};
     void clocker();
 };
 } // namespace scc
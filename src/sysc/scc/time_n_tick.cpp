@@ -41,18 +41,22 @@ void tick2time::end_of_elaboration() {
         this->clk_period = clk_if->period();
         clk_o.write(clk_period);
     } else {
+        // a method sampling the posedges, the output is only written if the measured period changes
         sc_core::sc_spawn_options opts;
-        opts.set_stack_size(0x1000);
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&clk_i.pos());
         sc_core::sc_spawn(
             [this]() {
-                while(true) {
-                    wait(clk_i.posedge_event());
-                    clk_period = sc_core::sc_time_stamp() - last_tick;
+                auto const now = sc_core::sc_time_stamp();
+                if(ticked && now - last_tick != clk_period) {
+                    clk_period = now - last_tick;
                     clk_o.write(clk_period);
-                    last_tick = sc_core::sc_time_stamp();
                 }
+                last_tick = now;
+                ticked = true;
             },
-            nullptr, &opts);
+            sc_core::sc_gen_unique_name("period_sampler"), &opts);
     }
 }
 #ifdef CWR_SYSTEMC
@@ -63,17 +67,32 @@ void tick2time::handle_clock_parameters_updated(scml_clock_if* clk_if) {
 void tick2time::handle_clock_deleted(scml_clock_if*){};
 #endif
 
-inline void time2tick::clocker() {
-    while(true) {
-        auto t = clk_i.read();
-        if(t == sc_core::SC_ZERO_TIME) {
-            wait(clk_i.value_changed_event());
-            t = clk_i.read();
+void time2tick::end_of_elaboration() {
+    wake_evts |= clk_i.value_changed_event();
+    if(gate_i.get_interface())
+        wake_evts |= gate_i.value_changed_event();
+}
+
+void time2tick::clocker() {
+    auto const now = sc_core::sc_time_stamp();
+    auto const period = clk_i.read();
+    if(period == sc_core::SC_ZERO_TIME || (gate_i.get_interface() && !gate_i.read())) {
+        // stopped clock: only wake up again if the period or the gate changes
+        if(level) {
+            level = false;
+            clk_o.write(false);
         }
-        clk_o = true;
-        wait(t / 2);
-        clk_o = false;
-        wait(t - t / 2);
+        running = false;
+        next_trigger(wake_evts);
+        return;
+    }
+    if(!running || now >= next_edge) {
+        level = !running || !level;
+        clk_o.write(level);
+        running = true;
+        // a new period takes effect at the next edge
+        next_edge = now + (level ? period / 2 : period - period / 2);
     }
+    next_trigger(next_edge - now, wake_evts);
 }
 } // namespace scc
@@ -46,6 +46,11 @@ void close_vcd_mt_trace_file(sc_core::sc_trace_file* tf);
 sc_core::sc_trace_file* create_fst_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
 //! close the FST file
 void close_fst_trace_file(sc_core::sc_trace_file* tf);
+
+//! create columnar trace file (CTF) which uses pull mechanism and multithreaded compression
+sc_core::sc_trace_file* create_ctf_trace_file(const char* name, std::function<bool()> enable = std::function<bool()>());
+//! close the CTF file
+void close_ctf_trace_file(sc_core::sc_trace_file* tf);
 } // namespace scc
 /** @} */ // end of scc-sysc
 #endif    // SCC_SC_VCD_TRACE_H
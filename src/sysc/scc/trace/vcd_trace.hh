@@ -23,6 +23,7 @@
 #define FPTR FILE*
 #endif
 #include <util/ities.h>
+#include <util/string_interner.h>
 #include <scc/utilities.h>
 #include <fmt/format.h>
 #include <vector>
@@ -64,17 +65,20 @@ inline size_t get_buffer_size(int length){
 template<typename T>
 struct vcd_scope_stack {
     void add_trace(T *trace){
-        auto hier = util::split(trace->name, '.');
+        // the name components are kept as symbols of the string interner, they are shared among all traces
+        auto& interner = util::string_interner::get();
+        auto hier = interner.components(interner.intern_path(trace->name));
         add_trace_rec(std::begin(hier), std::end(hier), trace);
     }
 
     void print(FPTR os, const char *scope_name = "SystemC"){
         auto buf = fmt::format("$scope module {} $end\n", scope_name);
         FWRITE(buf.c_str(), 1, buf.size(), os);
+        auto& interner = util::string_interner::get();
         for (auto& e : m_traces)
-            print_variable_declaration_line(os, e.first.c_str(), e.second);
+            print_variable_declaration_line(os, interner.str(e.first).c_str(), e.second);
         for (auto& e : m_scopes)
-            e.second->print(os,e.first.c_str());
+            e.second->print(os, interner.str(e.first).c_str());
         std::string end = "$upscope $end\n";
         FWRITE(end.c_str(), 1, end.size(), os);
     }
@@ -84,7 +88,8 @@ struct vcd_scope_stack {
             delete s.second;
     }
 private:
-    void add_trace_rec(std::vector<std::string>::iterator beg, std::vector<std::string>::iterator const& end, T *trace){
+    using symbol_id = util::string_interner::id_type;
+    void add_trace_rec(std::vector<symbol_id>::iterator beg, std::vector<symbol_id>::iterator const& end, T *trace){
         if(std::distance(beg,  end)==1){
             m_traces.push_back(std::make_pair(*beg, trace));
         } else {
@@ -119,8 +124,8 @@ private:
         }
     }
 
-    std::vector<std::pair<std::string,T*> > m_traces{0};
-    std::unordered_map<std::string, vcd_scope_stack*> m_scopes{0};
+    std::vector<std::pair<symbol_id,T*> > m_traces{0};
+    std::unordered_map<symbol_id, vcd_scope_stack*> m_scopes{0};
 };
 
 struct vcd_trace {
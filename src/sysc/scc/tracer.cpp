@@ -42,6 +42,7 @@
 #include <iostream>
 #include <lwtr/lwtr.h>
 #include <sstream>
+#include <util/string_interner.h>
 
 using namespace sc_core;
 using namespace scc;
@@ -68,6 +69,11 @@ tracer::tracer(std::string const&& name, file_type tx_type, file_type sig_type,
         case FST:
             trf = scc::create_fst_trace_file(name.c_str());
             break;
+#ifdef WITH_CTF
+        case CTF:
+            trf = scc::create_ctf_trace_file(name.c_str());
+            break;
+#endif
         }
     }
     if(trf)
@@ -140,6 +146,10 @@ void tracer::init_tx_db(file_type type, std::string const&& name) {
             SCVNS scv_tr_mtc_init();
             ss << ".txlog";
             break;
+        case SHARDED:
+            SCVNS scv_tr_lz4_sharded_init(tx_shards.get_value());
+            ss << ".txlog";
+            break;
         }
         if(type == LWFTR || type == LWCFTR) {
             lwtr_db = new lwtr::tx_db(name.c_str());
@@ -164,6 +174,9 @@ void tracer::end_of_elaboration() {
 }
 
 void tracer::end_of_simulation() {
+    auto stats = util::string_interner::get().get_stats();
+    SCCDEBUG(name()) << "string interner holds " << stats.symbols << " symbols and " << stats.paths << " paths ("
+                     << stats.materialized_paths << " materialized) using approx. " << stats.bytes << " bytes";
     if(close_db_in_eos.get_value()) {
         delete txdb;
         txdb = nullptr;
@@ -55,6 +55,9 @@ public:
      * @brief defines the transaction trace output type
      *
      * CUSTOM means the caller needs to initialize the database driver (scv_tr_text_init() or alike)
+     * SHARDED writes the transactions into several LZ4 compressed text databases in parallel, see also tx_shards
+     * CTF writes the signals into a columnar, block compressed trace file (see scc::ctf_trace_file), without lz4 support
+     * a VCD file is written instead
      */
     enum file_type {
         NONE,
@@ -67,10 +70,12 @@ public:
         LWFTR,
         LWCFTR,
         CUSTOM,
+        SHARDED,
         SC_VCD = TEXT,
         PULL_VCD = COMPRESSED,
         PUSH_VCD = SQLITE,
-        FST
+        FST,
+        CTF
     };
     /**
      * cci parameter to determine the file type being used to trace transaction if not specified explicitly
@@ -82,6 +87,11 @@ public:
      */
     cci::cci_param<unsigned> sig_trace_type{"sig_trace_type", FST,
                                             "Type of signal trace file used for recording. See also scc::tracer::wave_type"};
+    /**
+     * cci parameter to determine the number of shards written in parallel if the SHARDED transaction trace type is used
+     */
+    cci::cci_param<unsigned> tx_shards{"tx_shards", 0,
+                                       "Number of shards used by the SHARDED transaction trace type, 0 means one per hardware thread"};
     /**
      * cci parameter to determine the file type being used to trace signals if not specified explicitly
      */
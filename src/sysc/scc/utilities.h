@@ -28,6 +28,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #endif
 #include <systemc>
+#include <util/string_interner.h>
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
@@ -48,14 +49,26 @@ template <typename T, typename... Args> std::unique_ptr<T> make_unique(Args&&...
     return std::make_unique<T>(std::forward<Args>(args)...);
 #endif
 }
+/**
+ * @brief returns the hierarchical name of a child of an object. The name is kept in the string interner so it is
+ * built only once and the hierarchical name of the object is shared among all its children.
+ *
+ * @param obj the parent object
+ * @param child the name of the child
+ * @return the hierarchical name of the child
+ */
+inline std::string const& hier_name(sc_core::sc_object const* obj, std::string const& child) {
+    auto& interner = util::string_interner::get();
+    return interner.child_path_str(interner.intern_path(obj->name()), child);
+}
 } // namespace scc
 //! macros to simplify constructor lists
 #define NAMED(X, ...) X(#X, ##__VA_ARGS__)
 #define NAMEDD(X, T, ...) X(scc::make_unique<T>(#X, ##__VA_ARGS__))
 #define NAMEDC(X, T, I, ...) X(T::create<I>(#X, ##__VA_ARGS__))
 //! macros to simplify declaration of members to trace
-#define TRACE_VAR(F, X) sc_core::sc_trace(F, X, std::string(this->name()) + "." #X)
-#define TRACE_ARR(F, X, I) sc_core::sc_trace(F, X[I], (std::string(this->name()) + "." #X "(" + std::to_string(I) + ")").c_str());
+#define TRACE_VAR(F, X) sc_core::sc_trace(F, X, scc::hier_name(this, #X))
+#define TRACE_ARR(F, X, I) sc_core::sc_trace(F, X[I], scc::hier_name(this, #X "(" + std::to_string(I) + ")").c_str());
 #define TRACE_SIG(F, X) sc_core::sc_trace(F, X, X.name())
 
 namespace sc_core {
@@ -21,6 +21,7 @@
 #include <sysc/datatypes/fx/sc_fxnum.h>
 #include <sysc/datatypes/fx/sc_fxval.h>
 #include <unordered_map>
+#include <util/string_interner.h>
 
 using namespace sc_core;
 namespace scc {
@@ -63,7 +64,7 @@ public:
                 sc_get_curr_simcontext()->hierarchy_push(mod);                                                                             \
                 auto* o = new sc_ref_variable<tp>(name, object);                                                                           \
                 sc_get_curr_simcontext()->hierarchy_pop();                                                                                 \
-                holder[name] = o;                                                                                                          \
+                holder[util::string_interner::get().intern_path(name)] = o;                                                                \
             }                                                                                                                              \
         }                                                                                                                                  \
     }
@@ -74,7 +75,7 @@ public:
                 sc_get_curr_simcontext()->hierarchy_push(mod);                                                                             \
                 auto* o = new sc_ref_variable_masked<tp>(name, object, width);                                                             \
                 sc_get_curr_simcontext()->hierarchy_pop();                                                                                 \
-                holder[name] = o;                                                                                                          \
+                holder[util::string_interner::get().intern_path(name)] = o;                                                                \
             }                                                                                                                              \
         }                                                                                                                                  \
     }                                                                                                                                      \
@@ -86,7 +87,7 @@ public:
                 sc_get_curr_simcontext()->hierarchy_push(mod);
                 auto* o = new sc_ref_variable<bool>(name.substr(strlen(mod->name()) + 1), object);
                 sc_get_curr_simcontext()->hierarchy_pop();
-                holder[name] = o;
+                holder[util::string_interner::get().intern_path(name)] = o;
             }
         }
     }
@@ -156,7 +157,8 @@ public:
             delete kv.second;
     }
 
-    std::unordered_map<std::string, sc_variable_b*> holder;
+    // the registered variables keyed by the interned path of their hierarchical name
+    std::unordered_map<util::string_interner::id_type, sc_variable_b*> holder;
 
     sc_dt::uint64 dummy = 0;
 #ifdef NCSC
@@ -175,14 +177,15 @@ auto scc::value_registry::get_names() const -> std::vector<std::string> {
     auto& holder = dynamic_cast<value_registry_impl*>(trf)->holder;
     std::vector<std::string> keys;
     keys.reserve(holder.size());
+    auto& interner = util::string_interner::get();
     for(auto kv : holder)
-        keys.push_back(kv.first);
+        keys.push_back(interner.path_str(kv.first));
     return keys;
 }
 
 auto scc::value_registry::get_value(std::string name) const -> const sc_variable_b* {
     auto* reg = dynamic_cast<value_registry_impl*>(trf);
-    auto it = reg->holder.find(name);
+    auto it = reg->holder.find(util::string_interner::get().find_path(name));
     if(it != reg->holder.end()) {
         std::cerr << "returning value holder ptr" << std::endl;
         return it->second;
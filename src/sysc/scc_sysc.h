@@ -22,10 +22,13 @@
  * This module contains generic C++ functions being independent of SystemC
  */
 /**@{*/
+#include "scc/async_channel.h"
+#include "scc/cached_param.h"
 #include "scc/configurable_tracer.h"
 #include "scc/configurer.h"
 #include "scc/ext_attribute.h"
 #include "scc/fifo_w_cb.h"
+#include "scc/fixed_bv.h"
 #include "scc/hierarchy_dumper.h"
 #include "scc/mt19937_rng.h"
 #include "scc/ordered_semaphore.h"
@@ -60,6 +63,9 @@
 #include "tlm/scc/tlm_extensions.h"
 #include "tlm/scc/tlm_id.h"
 #include "tlm/scc/tlm_mm.h"
+#include "tlm/scc/tlm_stats.h"
+#include "tlm/scc/tlm_stats_sockets.h"
+#include "tlm/scc/tx_recording_policy.h"
 #if(SYSTEMC_VERSION >= 20171012)
 #include "tlm/scc/signal_initiator_mixin.h"
 #include "tlm/scc/signal_target_mixin.h"
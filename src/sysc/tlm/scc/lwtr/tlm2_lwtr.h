@@ -27,7 +27,9 @@
 #include <tlm/scc/lwtr/lwtr4tlm2_extension_registry.h>
 #include <tlm/scc/tlm_gp_shared.h>
 #include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tx_recording_policy.h>
 #include <unordered_map>
+#include <unordered_set>
 
 //! @brief LWTR components for TLM2
 namespace tlm {
@@ -68,6 +70,15 @@ struct nb_rec_entry {
     uintptr_t const id;
     tx_handle parent;
 };
+//! a transaction (blocking) or a transport call (non-blocking) kept for the error window
+struct buffered_rec_entry {
+    enum { BL, NB_FW, NB_BW } kind{BL};
+    tlm::scc::tlm_gp_shared_ptr tr;
+    sc_core::sc_time start_time, end_time;
+    sc_core::sc_time delay, delay_ret;
+    tlm::tlm_phase phase, phase_ret;
+    tlm::tlm_sync_enum status{tlm::TLM_ACCEPTED};
+};
 
 /*! \brief The TLM2 transaction recorder
  *
@@ -92,6 +103,9 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     cci::cci_param<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the policy selecting which transactions get recorded (time window, sampling, trigger, error window)
+    tx_recording_policy recording_policy;
+
     /**
      * @fn  tlm2_lwtr(bool=true, tr_db*=tr_db::get_default_db())
      * @brief The constructor of the component
@@ -118,6 +132,7 @@ public:
     tlm2_lwtr(const char* full_name, bool recording_enabled = true, tx_db* tr_db = tx_db::get_default_db())
     : enableBlTracing("enableBlTracing", recording_enabled)
     , enableNbTracing("enableNbTracing", recording_enabled)
+    , recording_policy(full_name)
     , full_name(full_name)
     , nb_timed_peq()
     , m_db(tr_db) {
@@ -127,9 +142,11 @@ public:
         opts.set_sensitivity(&nb_timed_peq.event());
         sc_core::sc_spawn([this]() { nbtx_cb(); }, nullptr, &opts);
         initialize_streams();
+        recording_policy.set_flush_callback([this]() { flush_buffered_tx(); });
     }
 
     virtual ~tlm2_lwtr() override {
+        flush_error_window();
         nbtx_req_handle_map.clear();
         nbtx_last_req_handle_map.clear();
         delete b_streamHandle;
@@ -267,6 +284,78 @@ private:
     tx_generator<>* dmi_trGetHandle{nullptr};
     tx_generator<sc_dt::uint64, sc_dt::uint64>* dmi_trInvalidateHandle{nullptr};
 
+    //! the buffer of transactions while waiting for an error report
+    tx_ring_buffer<buffered_rec_entry> tx_buffer;
+    //! the non-blocking transactions selected by the recording policy
+    std::unordered_set<void*> nbtx_selected;
+    /*! \brief determine how to handle a blocking transaction
+     *
+     * \return the decision of the recording policy
+     */
+    inline tx_recording_policy::decision get_bl_decision() {
+        if(!recording_policy.is_active())
+            return tx_recording_policy::RECORD;
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+        return recording_policy.decide();
+    }
+    /*! \brief determine how to handle a non-blocking transport call. The decision is taken when the request starts
+     * and applies to all subsequent calls of the same transaction
+     *
+     * \return the decision of the recording policy
+     */
+    inline tx_recording_policy::decision get_nb_decision(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                         DIR dir) {
+        if(!recording_policy.is_active())
+            return tx_recording_policy::RECORD;
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+        if(dir == FW && phase == tlm::BEGIN_REQ) {
+            auto ret = recording_policy.decide();
+            if(ret == tx_recording_policy::SKIP)
+                nbtx_selected.erase(&trans);
+            else
+                nbtx_selected.insert(&trans);
+            return ret;
+        }
+        return nbtx_selected.count(&trans) ? recording_policy.current() : tx_recording_policy::SKIP;
+    }
+    //! \brief store a snapshot of the transaction in the error window buffer
+    inline void buffer_tx(buffered_rec_entry&& e, typename TYPES::tlm_payload_type& trans) {
+        e.tr = mm::get().allocate();
+        e.tr->deep_copy_from(trans);
+        e.end_time = sc_core::sc_time_stamp();
+        tx_buffer.push(std::move(e), recording_policy.get_error_window(), recording_policy.get_error_buffer_size());
+    }
+    //! \brief write the buffered transactions to the database using their original time stamps
+    void flush_buffered_tx() {
+        tx_buffer.flush(recording_policy.get_error_window(), [this](buffered_rec_entry& e) {
+            if(e.kind == buffered_rec_entry::BL) {
+                tx_handle h = b_trHandle[e.tr->get_command()]->begin_tx_delayed(e.start_time, e.delay);
+                h.record_attribute("trans", *e.tr);
+                h.record_attribute("end_delay", e.delay_ret);
+                h.end_tx_delayed(e.end_time);
+            } else {
+                tx_handle h = nb_trHandle[e.kind == buffered_rec_entry::NB_FW ? FW : BW]->begin_tx_delayed(e.start_time, phase2string(e.phase));
+                h.record_attribute("delay", e.delay);
+                h.record_attribute("tlm_sync", e.status);
+                h.record_attribute("delay[return_path]", e.delay_ret);
+                h.record_attribute("trans", *e.tr);
+                h.record_attribute("tlm_phase[return_path]", phase2string(e.phase_ret));
+                h.end_tx_delayed(e.end_time);
+            }
+        });
+    }
+
+public:
+    /*! \brief write the buffered transactions if an error has been reported which has not been handled yet. This is
+     * called at the end of simulation and upon destruction
+     */
+    void flush_error_window() {
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+    }
+
 protected:
     void initialize_streams() {
         if(m_db) {
@@ -329,6 +418,9 @@ public:
         this->bw_port(ts.get_base_port());
         this->fw_port(is.get_base_port());
     }
+
+private:
+    void end_of_simulation() override { this->flush_error_window(); }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -340,6 +432,22 @@ template <typename TYPES> void tlm2_lwtr<TYPES>::b_transport(typename TYPES::tlm
         fw_port->b_transport(trans, delay);
         return;
     }
+    switch(get_bl_decision()) {
+    case tx_recording_policy::SKIP:
+        fw_port->b_transport(trans, delay);
+        return;
+    case tx_recording_policy::BUFFER: {
+        buffered_rec_entry e;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        fw_port->b_transport(trans, delay);
+        e.delay_ret = delay;
+        buffer_tx(std::move(e), trans);
+        return;
+    }
+    default:
+        break;
+    }
     // Get a handle for the new transaction
     tx_handle h = b_trHandle[trans.get_command()]->begin_tx(delay);
     tx_handle htim;
@@ -403,6 +511,27 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
                                                      sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return fw_port->nb_transport_fw(trans, phase, delay);
+    switch(get_nb_decision(trans, phase, FW)) {
+    case tx_recording_policy::SKIP:
+        return fw_port->nb_transport_fw(trans, phase, delay);
+    case tx_recording_policy::BUFFER: {
+        buffered_rec_entry e;
+        e.kind = buffered_rec_entry::NB_FW;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        e.phase = phase;
+        e.status = fw_port->nb_transport_fw(trans, phase, delay);
+        e.delay_ret = delay;
+        e.phase_ret = phase;
+        auto status = e.status;
+        buffer_tx(std::move(e), trans);
+        if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_ACCEPTED && phase == tlm::END_RESP))
+            nbtx_selected.erase(&trans);
+        return status;
+    }
+    default:
+        break;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -451,6 +580,8 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_fw(typename TYPES::tlm_payload
                 extensionRecording->recordEndTx(h, trans);
     // get the extension and free the memory if it was mine
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_ACCEPTED && phase == tlm::END_RESP)) {
+        if(recording_policy.is_active())
+            nbtx_selected.erase(&trans);
         trans.get_extension(preExt);
         if(preExt && preExt->creator == this) {
             trans.set_extension(static_cast<link_pred_ext*>(nullptr));
@@ -481,6 +612,27 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload
                                                      sc_core::sc_time& delay) {
     if(!isRecordingNonBlockingTxEnabled())
         return bw_port->nb_transport_bw(trans, phase, delay);
+    switch(get_nb_decision(trans, phase, BW)) {
+    case tx_recording_policy::SKIP:
+        return bw_port->nb_transport_bw(trans, phase, delay);
+    case tx_recording_policy::BUFFER: {
+        buffered_rec_entry e;
+        e.kind = buffered_rec_entry::NB_BW;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        e.phase = phase;
+        e.status = bw_port->nb_transport_bw(trans, phase, delay);
+        e.delay_ret = delay;
+        e.phase_ret = phase;
+        auto status = e.status;
+        buffer_tx(std::move(e), trans);
+        if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP))
+            nbtx_selected.erase(&trans);
+        return status;
+    }
+    default:
+        break;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -526,6 +678,8 @@ tlm::tlm_sync_enum tlm2_lwtr<TYPES>::nb_transport_bw(typename TYPES::tlm_payload
     // get the extension and free the memory if it was mine
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP)) {
         // the transaction is finished
+        if(recording_policy.is_active())
+            nbtx_selected.erase(&trans);
         if(preExt && preExt->creator == this) {
             // clean-up the extension if this is the original creator
             trans.set_extension(static_cast<link_pred_ext*>(nullptr));
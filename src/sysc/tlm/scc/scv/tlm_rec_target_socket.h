@@ -114,7 +114,12 @@ public:
         recorder.setExtensionRecording(extensionRecording);
     }
 
+    //! \brief get the policy selecting which transactions get recorded
+    tx_recording_policy& get_recording_policy() { return recorder.recording_policy; }
+
 protected:
+    void end_of_simulation() override { recorder.flush_error_window(); }
+
     sc_core::sc_port<fw_interface_type> fw_port{sc_core::sc_gen_unique_name("$$$__rec_fw__$$$")};
     scv::tlm_recorder<TYPES> recorder;
 };
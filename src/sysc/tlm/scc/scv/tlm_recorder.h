@@ -25,9 +25,13 @@
 #include <string>
 #include <sysc/kernel/sc_dynamic_processes.h>
 #include <tlm/scc/tlm_mm.h>
+#include <tlm/scc/tx_recording_policy.h>
 #include <tlm>
 #include <tlm_utils/peq_with_cb_and_phase.h>
 #include <unordered_map>
+#include <unordered_set>
+#include <util/string_interner.h>
+#include <vector>
 
 //! @brief SystemC TLM
 namespace tlm {
@@ -102,6 +106,9 @@ public:
     //! \brief the attribute to selectively enable/disable DMI recording
     sc_core::sc_attribute<bool> enableDmiTracing{"enableDmiTracing", false};
 
+    //! \brief the policy selecting which transactions get recorded (time window, sampling, trigger, error window)
+    tx_recording_policy recording_policy;
+
     //! \brief the port where fw accesses are forwarded to
     sc_core::sc_port_b<tlm::tlm_fw_transport_if<TYPES>>& fw_port;
 
@@ -143,14 +150,18 @@ public:
                  SCVNS scv_tr_db* tr_db = SCVNS scv_tr_db::get_default_db())
     : enableBlTracing("enableBlTracing", recording_enabled)
     , enableNbTracing("enableNbTracing", recording_enabled)
+    , recording_policy(name)
     , fw_port(fw_port)
     , bw_port(bw_port)
     , b_timed_peq(this, &tlm_recorder::btx_cb)
     , nb_timed_peq(this, &tlm_recorder::nbtx_cb)
     , m_db(tr_db)
-    , fixed_basename(name) {}
+    , fixed_basename(name) {
+        recording_policy.set_flush_callback([this]() { flush_buffered_tx(); });
+    }
 
     virtual ~tlm_recorder() override {
+        flush_error_window();
         btx_handle_map.clear();
         nbtx_req_handle_map.clear();
         nbtx_last_req_handle_map.clear();
@@ -287,7 +298,106 @@ private:
     SCVNS scv_tr_generator<>* dmi_trGetHandle{nullptr};
     SCVNS scv_tr_generator<sc_dt::uint64, sc_dt::uint64>* dmi_trInvalidateHandle{nullptr};
 
+    //! a transaction (blocking) or a transport call (non-blocking) kept for the error window
+    struct buffered_tx {
+        enum { BL, NB_FW, NB_BW } kind{BL};
+        tlm_recording_payload* trans{nullptr};
+        sc_core::sc_time start_time, end_time;
+        sc_core::sc_time delay, delay_ret;
+        tlm::tlm_phase phase, phase_ret;
+        tlm::tlm_sync_enum status{tlm::TLM_ACCEPTED};
+        buffered_tx() = default;
+        buffered_tx(buffered_tx&& o)
+        : kind(o.kind)
+        , trans(o.trans)
+        , start_time(o.start_time)
+        , end_time(o.end_time)
+        , delay(o.delay)
+        , delay_ret(o.delay_ret)
+        , phase(o.phase)
+        , phase_ret(o.phase_ret)
+        , status(o.status) {
+            o.trans = nullptr;
+        }
+        buffered_tx(buffered_tx const&) = delete;
+        ~buffered_tx() {
+            if(trans)
+                trans->release();
+        }
+    };
+    //! the buffer of transactions while waiting for an error report
+    tx_ring_buffer<buffered_tx> tx_buffer;
+    //! the non-blocking transactions selected by the recording policy
+    std::unordered_set<void*> nbtx_selected;
+    /*! \brief determine how to handle a blocking transaction
+     *
+     * \return the decision of the recording policy
+     */
+    inline tx_recording_policy::decision get_bl_decision() {
+        if(!recording_policy.is_active())
+            return tx_recording_policy::RECORD;
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+        return recording_policy.decide();
+    }
+    /*! \brief determine how to handle a non-blocking transport call. The decision is taken when the request starts
+     * and applies to all subsequent calls of the same transaction
+     *
+     * \return the decision of the recording policy
+     */
+    inline tx_recording_policy::decision get_nb_decision(typename TYPES::tlm_payload_type& trans, typename TYPES::tlm_phase_type& phase,
+                                                         DIR dir) {
+        if(!recording_policy.is_active())
+            return tx_recording_policy::RECORD;
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+        if(dir == FW && phase == tlm::BEGIN_REQ) {
+            auto ret = recording_policy.decide();
+            if(ret == tx_recording_policy::SKIP)
+                nbtx_selected.erase(&trans);
+            else
+                nbtx_selected.insert(&trans);
+            return ret;
+        }
+        return nbtx_selected.count(&trans) ? recording_policy.current() : tx_recording_policy::SKIP;
+    }
+    //! \brief store a snapshot of the transaction in the error window buffer
+    inline void buffer_tx(buffered_tx&& e, typename TYPES::tlm_payload_type& trans) {
+        e.trans = mm::get().allocate();
+        e.trans->acquire();
+        (*e.trans) = trans;
+        e.end_time = sc_core::sc_time_stamp();
+        tx_buffer.push(std::move(e), recording_policy.get_error_window(), recording_policy.get_error_buffer_size());
+    }
+    //! \brief write the buffered transactions to the database using their original time stamps
+    void flush_buffered_tx() {
+        tx_buffer.flush(recording_policy.get_error_window(), [this](buffered_tx& e) {
+            if(e.kind == buffered_tx::BL) {
+                auto* gen = b_trHandle[e.trans->get_command()];
+                SCVNS scv_tr_handle h = gen->begin_transaction(e.delay.value(), e.start_time);
+                record(h, *e.trans);
+                gen->end_transaction(h, e.delay_ret.value(), e.end_time);
+            } else {
+                auto* gen = nb_trHandle[e.kind == buffered_tx::NB_FW ? FW : BW];
+                SCVNS scv_tr_handle h = gen->begin_transaction(phase2string(e.phase), e.start_time);
+                h.record_attribute("delay", e.delay.to_string());
+                record(h, e.status);
+                h.record_attribute("delay[return_path]", e.delay_ret.to_string());
+                record(h, *e.trans);
+                gen->end_transaction(h, phase2string(e.phase_ret), e.end_time);
+            }
+        });
+    }
+
 public:
+    /*! \brief write the buffered transactions if an error has been reported which has not been handled yet. This is
+     * called at the end of simulation and upon destruction
+     */
+    void flush_error_window() {
+        if(recording_policy.flush_requested())
+            flush_buffered_tx();
+    }
+
     void initialize_streams() {
         if(isRecordingBlockingTxEnabled() && !b_streamHandle) {
             b_streamHandle = new SCVNS scv_tr_stream((fixed_basename + "_bl").c_str(), "[TLM][base-protocol][b]", m_db);
@@ -328,11 +438,20 @@ public:
 
 private:
     const std::string fixed_basename;
-    inline std::string phase2string(const tlm::tlm_phase& p) {
-        std::stringstream ss;
-        ss << p;
-        return ss.str();
+    // the phase names are formatted once and kept in the shared string interner
+    inline std::string const& phase2string(const tlm::tlm_phase& p) {
+        unsigned id = p;
+        if(id >= phase_names.size())
+            phase_names.resize(id + 1, nullptr);
+        if(!phase_names[id]) {
+            std::stringstream ss;
+            ss << p;
+            auto& interner = util::string_interner::get();
+            phase_names[id] = &interner.str(interner.intern(ss.str()));
+        }
+        return *phase_names[id];
     }
+    std::vector<std::string const*> phase_names;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -346,6 +465,22 @@ template <typename TYPES> void tlm_recorder<TYPES>::b_transport(typename TYPES::
         return;
     } else if(!b_streamHandle)
         initialize_streams();
+    switch(get_bl_decision()) {
+    case tx_recording_policy::SKIP:
+        fw_port->b_transport(trans, delay);
+        return;
+    case tx_recording_policy::BUFFER: {
+        buffered_tx e;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        fw_port->b_transport(trans, delay);
+        e.delay_ret = delay;
+        buffer_tx(std::move(e), trans);
+        return;
+    }
+    default:
+        break;
+    }
     // Get a handle for the new transaction
     SCVNS scv_tr_handle h = b_trHandle[trans.get_command()]->begin_transaction(delay.value(), sc_core::sc_time_stamp());
     /*************************************************************************
@@ -430,6 +565,27 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
         return fw_port->nb_transport_fw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    switch(get_nb_decision(trans, phase, FW)) {
+    case tx_recording_policy::SKIP:
+        return fw_port->nb_transport_fw(trans, phase, delay);
+    case tx_recording_policy::BUFFER: {
+        buffered_tx e;
+        e.kind = buffered_tx::NB_FW;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        e.phase = phase;
+        e.status = fw_port->nb_transport_fw(trans, phase, delay);
+        e.delay_ret = delay;
+        e.phase_ret = phase;
+        auto status = e.status;
+        buffer_tx(std::move(e), trans);
+        if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_ACCEPTED && phase == tlm::END_RESP))
+            nbtx_selected.erase(&trans);
+        return status;
+    }
+    default:
+        break;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -479,6 +635,8 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_fw(typename TYPES::tlm_payl
             extensionRecording->recordEndTx(h, trans);
     // get the extension and free the memory if it was mine
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_ACCEPTED && phase == tlm::END_RESP)) {
+        if(recording_policy.is_active())
+            nbtx_selected.erase(&trans);
         trans.get_extension(preExt);
         if(preExt && preExt->get_creator() == this) {
             trans.set_extension(static_cast<tlm_recording_extension*>(nullptr));
@@ -515,6 +673,27 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
         return bw_port->nb_transport_bw(trans, phase, delay);
     else if(!nb_streamHandle)
         initialize_streams();
+    switch(get_nb_decision(trans, phase, BW)) {
+    case tx_recording_policy::SKIP:
+        return bw_port->nb_transport_bw(trans, phase, delay);
+    case tx_recording_policy::BUFFER: {
+        buffered_tx e;
+        e.kind = buffered_tx::NB_BW;
+        e.start_time = sc_core::sc_time_stamp();
+        e.delay = delay;
+        e.phase = phase;
+        e.status = bw_port->nb_transport_bw(trans, phase, delay);
+        e.delay_ret = delay;
+        e.phase_ret = phase;
+        auto status = e.status;
+        buffer_tx(std::move(e), trans);
+        if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP))
+            nbtx_selected.erase(&trans);
+        return status;
+    }
+    default:
+        break;
+    }
     /*************************************************************************
      * prepare recording
      *************************************************************************/
@@ -560,6 +739,8 @@ tlm::tlm_sync_enum tlm_recorder<TYPES>::nb_transport_bw(typename TYPES::tlm_payl
     nb_trHandle[BW]->end_transaction(h, phase2string(phase));
     if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_RESP)) {
         // the transaction is finished
+        if(recording_policy.is_active())
+            nbtx_selected.erase(&trans);
         if(preExt && preExt->get_creator() == this) {
             // clean-up the extension if this is the original creator
             trans.set_extension(static_cast<tlm_recording_extension*>(nullptr));
@@ -75,6 +75,8 @@ public:
 
 private:
     void start_of_simulation() override { recorder->initialize_streams(); }
+
+    void end_of_simulation() override { recorder->flush_error_window(); }
 };
 } // namespace scv
 } // namespace scc
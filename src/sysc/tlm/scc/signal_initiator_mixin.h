@@ -20,6 +20,7 @@
 #include "scc/utilities.h"
 #include <functional>
 #include <sstream>
+#include <vector>
 #include <tlm/scc/tlm_signal.h>
 
 //! @brief SystemC TLM
@@ -49,8 +50,19 @@ public:
 
     using BASE_TYPE::bind;
 
+    /**
+     * @brief sends a value change without delay. If all bound targets opted into direct updates (see
+     * tlm_signal_direct_if) the value is passed by a direct call, otherwise a payload from the socket's pool is sent.
+     *
+     * @param value the new value
+     */
     void write_now(tlm_signal_type value) {
-        auto* gp = tlm_signal_gp<tlm_signal_type>::create();
+        if(use_direct_write()) {
+            for(auto* d : direct_targets)
+                d->write_direct(value);
+            return;
+        }
+        auto* gp = pool.create();
         gp->set_command(tlm::TLM_WRITE_COMMAND);
         gp->set_value(value);
         gp->acquire();
@@ -61,7 +73,7 @@ public:
     }
 
     template <typename EXT_TYPE> void write_now(tlm_signal_type value, EXT_TYPE* ext) {
-        auto* gp = tlm_signal_gp<tlm_signal_type>::create();
+        auto* gp = pool.create();
         gp->set_command(tlm::TLM_WRITE_COMMAND);
         gp->set_value(value);
         if(ext)
@@ -146,7 +158,26 @@ private:
     };
 
 private:
+    bool use_direct_write() {
+        if(!direct_resolved) {
+            direct_resolved = true;
+            auto& p = this->get_base_port();
+            for(int i = 0; i < p.size(); ++i) {
+                auto* d = dynamic_cast<tlm_signal_direct_if<tlm_signal_type>*>(p.get_interface(i));
+                if(!d || !d->direct_write_enabled()) {
+                    direct_targets.clear();
+                    break;
+                }
+                direct_targets.push_back(d);
+            }
+        }
+        return direct_targets.size();
+    }
+
     bw_transport_if bw_if;
+    typename tlm_signal_gp<tlm_signal_type>::gp_mm pool;
+    std::vector<tlm_signal_direct_if<tlm_signal_type>*> direct_targets;
+    bool direct_resolved{false};
 };
 } // namespace scc
 } // namespace tlm
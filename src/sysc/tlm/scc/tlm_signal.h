@@ -26,10 +26,19 @@ namespace tlm {
 //! @brief SCC TLM utilities
 namespace scc {
 
+/**
+ * @brief a signal channel connecting tlm_signal sockets
+ *
+ * Value changes without delay arriving within the same delta cycle are coalesced into a single update of the signal
+ * value, only delayed changes are scheduled through a priority event queue. Incoming transactions are forwarded
+ * unchanged to the sockets bound to out. If enabled using set_direct_write() initiators may bypass the payload handling
+ * and update the value by a direct function call.
+ */
 template <typename SIG = bool, typename TYPES = tlm_signal_baseprotocol_types<SIG>, int N = 32>
 struct tlm_signal : public sc_core::sc_module,
                     public tlm_signal_fw_transport_if<SIG, TYPES>,
                     public tlm_signal_bw_transport_if<SIG, TYPES>,
+                    public tlm_signal_direct_if<SIG>,
                     sc_core::sc_signal_in_if<SIG> {
     using tlm_signal_type = SIG;
     using protocol_types = TYPES;
@@ -49,8 +58,14 @@ struct tlm_signal : public sc_core::sc_module,
         in.bind(*(tlm_signal_fw_transport_if<tlm_signal_type, protocol_types>*)this);
         out.bind(*(tlm_signal_bw_transport_if<tlm_signal_type, protocol_types>*)this);
         SC_METHOD(que_cb);
-        sensitive << que.event();
+        sensitive << que.event() << update_evt;
     }
+    //! enables direct value updates by initiators, needs to be called before the start of the simulation
+    void set_direct_write(bool enable) { direct_write = enable; }
+
+    bool direct_write_enabled() const override { return direct_write; }
+
+    void write_direct(SIG const& v) override;
 
     void trace(sc_core::sc_trace_file* tf) const override;
 
@@ -80,8 +95,19 @@ struct tlm_signal : public sc_core::sc_module,
     bool negedge() const override { return value.posedge(); };
 
 private:
+    void schedule(SIG const& v) {
+        pending_value = v;
+        if(!update_pending) {
+            update_pending = true;
+            update_evt.notify(sc_core::SC_ZERO_TIME);
+        }
+    }
     void que_cb();
     ::scc::peq<tlm_signal_type> que;
+    sc_core::sc_event update_evt;
+    tlm_signal_type pending_value{};
+    bool update_pending{false};
+    bool direct_write{false};
     sc_core::sc_signal<tlm_signal_type> value;
 };
 
@@ -91,7 +117,10 @@ template <typename SIG, typename TYPES, int N> void tlm_signal<SIG, TYPES, N>::t
 
 template <typename SIG, typename TYPES, int N>
 tlm_sync_enum tlm_signal<SIG, TYPES, N>::nb_transport_fw(payload_type& gp, phase_type& phase, sc_core::sc_time& delay) {
-    que.notify(gp.get_value(), delay);
+    if(delay == sc_core::SC_ZERO_TIME)
+        schedule(gp.get_value());
+    else
+        que.notify(gp.get_value(), delay);
     auto& p = out.get_base_port();
     for(size_t i = 0; i < p.size(); ++i) {
         p.get_interface(i)->nb_transport_fw(gp, phase, delay);
@@ -108,9 +137,30 @@ tlm_sync_enum tlm_signal<SIG, TYPES, N>::nb_transport_bw(payload_type& gp, phase
     return TLM_COMPLETED;
 }
 
+template <typename SIG, typename TYPES, int N> void tlm_signal<SIG, TYPES, N>::write_direct(SIG const& v) {
+    schedule(v);
+    auto& p = out.get_base_port();
+    if(p.size()) {
+        auto* gp = payload_type::create();
+        gp->acquire();
+        gp->set_command(tlm::TLM_WRITE_COMMAND);
+        gp->set_value(v);
+        phase_type phase{tlm::BEGIN_REQ};
+        sc_core::sc_time delay{sc_core::SC_ZERO_TIME};
+        for(size_t i = 0; i < p.size(); ++i)
+            p.get_interface(i)->nb_transport_fw(*gp, phase, delay);
+        gp->release();
+    }
+}
+
 template <typename SIG, typename TYPES, int N> void tlm_signal<SIG, TYPES, N>::que_cb() {
     while(auto oi = que.get_next())
         value.write(oi.get());
+    // value changes without delay are more recent than the ones maturing from the queue
+    if(update_pending) {
+        update_pending = false;
+        value.write(pending_value);
+    }
 }
 } // namespace scc
 } // namespace tlm
@@ -27,8 +27,16 @@ namespace tlm {
 //! @brief SCC TLM utilities
 namespace scc {
 
+/**
+ * @brief converts tlm_signal transactions to sc_signal writes
+ *
+ * Value changes without delay arriving within the same delta cycle are coalesced into a single write. If enabled using
+ * set_direct_write() initiators may bypass the payload handling.
+ */
 template <typename TYPE>
-struct tlm_signal2sc_signal : public sc_core::sc_module, public tlm_signal_fw_transport_if<TYPE, tlm_signal_baseprotocol_types<TYPE>> {
+struct tlm_signal2sc_signal : public sc_core::sc_module,
+                              public tlm_signal_fw_transport_if<TYPE, tlm_signal_baseprotocol_types<TYPE>>,
+                              public tlm_signal_direct_if<TYPE> {
 
     using protocol_types = tlm_signal_baseprotocol_types<TYPE>;
     using payload_type = typename protocol_types::tlm_payload_type;
@@ -44,20 +52,45 @@ struct tlm_signal2sc_signal : public sc_core::sc_module, public tlm_signal_fw_tr
     : sc_core::sc_module(nm) {
         t_i.bind(*this);
         SC_METHOD(que_cb);
-        sensitive << que.event();
+        sensitive << que.event() << update_evt;
     }
+    //! enables direct value updates by initiators, needs to be called before the start of the simulation
+    void set_direct_write(bool enable) { direct_write = enable; }
+
+    bool direct_write_enabled() const override { return direct_write; }
+
+    void write_direct(TYPE const& v) override { schedule(v); }
 
 private:
     tlm_sync_enum nb_transport_fw(payload_type& gp, phase_type& phase, sc_core::sc_time& delay) {
-        que.notify(gp.get_value(), delay);
+        if(delay == sc_core::SC_ZERO_TIME)
+            schedule(gp.get_value());
+        else
+            que.notify(gp.get_value(), delay);
         return TLM_COMPLETED;
     }
 
+    void schedule(TYPE const& v) {
+        pending_value = v;
+        if(!update_pending) {
+            update_pending = true;
+            update_evt.notify(sc_core::SC_ZERO_TIME);
+        }
+    }
+
     void que_cb() {
         while(auto oi = que.get_next())
             s_o.write(oi.get());
+        if(update_pending) {
+            update_pending = false;
+            s_o.write(pending_value);
+        }
     }
     ::scc::peq<TYPE> que;
+    sc_core::sc_event update_evt;
+    TYPE pending_value{};
+    bool update_pending{false};
+    bool direct_write{false};
 };
 
 template <typename TYPE>
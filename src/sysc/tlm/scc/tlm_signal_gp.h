@@ -17,7 +17,9 @@
 #ifndef _TLM_TLM_SIGNAL_GP_H_
 #define _TLM_TLM_SIGNAL_GP_H_
 
-#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
 #ifdef CWR_SYSTEMC
 #include <tlm_h/tlm_generic_payload/tlm_gp.h>
 #else
@@ -168,17 +170,21 @@ template <typename SIG = bool> struct tlm_signal_gp : public tlm_generic_payload
     void set_response_status(const tlm_response_status response_status) { m_response_status = response_status; }
     std::string get_response_string() const;
 
+    /**
+     * @brief a pool of payloads, e.g. owned by a socket. It only hands out and takes back payloads of type
+     * tlm_signal_gp<SIG> hence no dynamic type check is needed upon return.
+     */
     struct gp_mm : public tlm_base_mm_interface {
         tlm_signal_gp<SIG>* create() {
             if(pool.size()) {
-                auto ret = pool.front();
-                pool.pop_front();
+                auto ret = pool.back();
+                pool.pop_back();
                 return ret;
             } else
                 return new tlm_signal_gp<SIG>(this);
         }
         void free(tlm_generic_payload_base* gp) override {
-            auto t = dynamic_cast<tlm_signal_gp<SIG>*>(gp);
+            auto t = static_cast<tlm_signal_gp<SIG>*>(gp);
             t->free_all_extensions();
             pool.push_back(t);
         }
@@ -188,23 +194,20 @@ template <typename SIG = bool> struct tlm_signal_gp : public tlm_generic_payload
         }
 
     private:
-        std::deque<tlm_signal_gp<SIG>*> pool;
+        std::vector<tlm_signal_gp<SIG>*> pool;
     };
 
     static tlm_signal_gp<SIG>* create() {
-    #ifdef MTContext
-        static std::map<sc_core::sc_simcontext*, gp_mm*> active;
-        sc_core::sc_simcontext* ctx = sc_core::sc_get_curr_simcontext();
-        auto it = active.find(ctx);
-        if (it == active.end()) {
-            active.insert({ctx, new gp_mm});
-            return active[ctx];
-        }
-        return it->second->create();
-    #else
+#ifdef MTContext
+        static std::map<sc_core::sc_simcontext*, std::unique_ptr<gp_mm>> active;
+        auto& mm = active[sc_core::sc_get_curr_simcontext()];
+        if(!mm)
+            mm.reset(new gp_mm);
+        return mm->create();
+#else
         static thread_local gp_mm mm;
         return mm.create();
-    #endif
+#endif
     }
 
 protected:
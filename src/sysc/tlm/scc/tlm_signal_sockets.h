@@ -55,6 +55,21 @@ struct tlm_signal_bw_transport_if : public virtual sc_core::sc_interface {
     virtual ::tlm::tlm_sync_enum nb_transport_bw(typename TYPES::tlm_payload_type&, ::tlm::tlm_phase&, sc_core::sc_time&) = 0;
 };
 
+/**
+ * @brief the direct value update interface of a signal target
+ *
+ * A target implementing this interface in addition to tlm_signal_fw_transport_if may opt into receiving plain value
+ * changes (no extensions, no delay) as a direct function call instead of a payload passed through nb_transport_fw.
+ * Initiators check for it once upon the first write.
+ */
+template <typename SIG = bool> struct tlm_signal_direct_if {
+    virtual ~tlm_signal_direct_if() = default;
+    //! returns true if the target accepts direct value updates, this must not change during simulation
+    virtual bool direct_write_enabled() const = 0;
+    //! the direct value update, it has the same effect as a TLM_WRITE_COMMAND with zero delay
+    virtual void write_direct(SIG const& value) = 0;
+};
+
 template <typename SIG = bool, typename TYPES = tlm_signal_baseprotocol_types<SIG>, int N = 1,
           sc_core::sc_port_policy POL = sc_core::SC_ONE_OR_MORE_BOUND>
 struct tlm_signal_initiator_socket
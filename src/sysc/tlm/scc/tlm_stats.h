@@ -0,0 +1,376 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _TLM_SCC_TLM_STATS_H_
+#define _TLM_SCC_TLM_STATS_H_
+
+#include <algorithm>
+#include <array>
+#include <cci_configuration>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <tlm>
+#include <unordered_map>
+#include <util/hdr_histogram.h>
+#include <vector>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+//! \brief interface of a transaction statistics collector as used by the tlm_stats_registry
+struct tlm_stats_if {
+    virtual ~tlm_stats_if() = default;
+    //! \brief the name of the collected stream
+    virtual std::string const& get_stats_name() const = 0;
+    //! \brief writes the statistics as JSON object
+    virtual void write_json(std::ostream& os) const = 0;
+    //! \brief writes the statistics as CSV lines of the form 'stream,metric,key,value'
+    virtual void write_csv(std::ostream& os) const = 0;
+};
+/**
+ * @brief the registry of all transaction statistics collectors
+ *
+ * The registry writes the statistics of all collectors into one file at the end of simulation. The file name is given by
+ * the CCI parameter 'tlm_stats.file' which is created with the first collector. It defaults to the value of the
+ * environment variable SCC_TLM_STATS_FILE or 'tlm_stats.json'. If the name ends with '.csv' the statistics are written
+ * as CSV, otherwise as JSON.
+ */
+class tlm_stats_registry {
+public:
+    //! \brief returns the registry
+    static tlm_stats_registry& get() {
+        static tlm_stats_registry inst;
+        return inst;
+    }
+    //! \brief adds a collector, the first one creates the parameter 'tlm_stats.file'
+    void add(tlm_stats_if* s) {
+        if(!file) {
+            auto* env = std::getenv("SCC_TLM_STATS_FILE");
+            file.reset(new cci::cci_param<std::string>("tlm_stats.file", std::string(env ? env : "tlm_stats.json"),
+                                                       "The name of the file the transaction statistics are written to",
+                                                       cci::CCI_ABSOLUTE_NAME));
+        }
+        collectors.push_back(s);
+    }
+    //! \brief removes a collector, the parameter is deleted with the last one so it does not outlive the broker
+    void remove(tlm_stats_if* s) {
+        collectors.erase(std::remove(collectors.begin(), collectors.end(), s), collectors.end());
+        if(collectors.empty())
+            file.reset();
+    }
+    //! \brief overrides the name of the file written by dump()
+    void set_file_name(std::string const& name) { file_name = name; }
+    //! \brief the name of the file written by dump()
+    std::string get_file_name() const {
+        if(file_name.size())
+            return file_name;
+        if(file)
+            return file->get_value();
+        auto* env = std::getenv("SCC_TLM_STATS_FILE");
+        return env ? env : "tlm_stats.json";
+    }
+    //! \brief writes the statistics of all collectors into the stats file, only the first call has an effect
+    void dump() {
+        if(dumped || collectors.empty())
+            return;
+        dumped = true;
+        auto name = get_file_name();
+        std::ofstream os(name);
+        if(os.is_open())
+            dump(os, name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0);
+    }
+    //! \brief writes the statistics of all collectors to a stream
+    void dump(std::ostream& os, bool csv) const {
+        if(csv) {
+            os << "stream,metric,key,value\n";
+            for(auto* s : collectors)
+                s->write_csv(os);
+        } else {
+            os << "{\n\"tlm_stats\": [";
+            for(auto it = collectors.begin(); it != collectors.end(); ++it) {
+                os << (it == collectors.begin() ? "\n" : ",\n");
+                (*it)->write_json(os);
+            }
+            os << "\n]\n}\n";
+        }
+    }
+
+private:
+    std::vector<tlm_stats_if*> collectors;
+    std::unique_ptr<cci::cci_param<std::string>> file;
+    std::string file_name;
+    bool dumped{false};
+};
+/**
+ * @brief a lightweight alternative to transaction recording collecting statistics of a transaction stream
+ *
+ * The collector is placed between an initiator and a target like the tlm_recorder and keeps with constant memory
+ * per stream:
+ * - latency histograms per command (b_transport: annotated end - annotated start, nb_transport: BEGIN_REQ to
+ *   BEGIN_RESP resp. TLM_COMPLETED),
+ * - the number of outstanding transactions (maximum and time weighted average),
+ * - the read and write throughput in bins of statsBinWidth; if the simulation runs longer than statsBins bins the bin
+ *   width is doubled by merging neighbouring bins,
+ * - the counts of the response status.
+ * The results are written by the tlm_stats_registry.
+ */
+template <typename TYPES = tlm::tlm_base_protocol_types>
+class tlm_stats : public virtual tlm::tlm_fw_transport_if<TYPES>, public virtual tlm::tlm_bw_transport_if<TYPES>, public tlm_stats_if {
+public:
+    using payload_type = typename TYPES::tlm_payload_type;
+    using phase_type = typename TYPES::tlm_phase_type;
+    //! \brief the initial width of a throughput bin
+    cci::cci_param<sc_core::sc_time> statsBinWidth;
+    //! \brief the number of throughput bins
+    cci::cci_param<unsigned> statsBins;
+    //! \brief the port where fw accesses are forwarded to
+    sc_core::sc_port_b<tlm::tlm_fw_transport_if<TYPES>>& fw_port;
+    //! \brief the port where bw accesses are forwarded to
+    sc_core::sc_port_b<tlm::tlm_bw_transport_if<TYPES>>& bw_port;
+    /**
+     * @brief the constructor of the collector
+     *
+     * @param name the name of the collected stream
+     * @param fw_port the port where fw accesses are forwarded to
+     * @param bw_port the port where bw accesses are forwarded to
+     */
+    tlm_stats(char const* name, sc_core::sc_port_b<tlm::tlm_fw_transport_if<TYPES>>& fw_port,
+              sc_core::sc_port_b<tlm::tlm_bw_transport_if<TYPES>>& bw_port)
+    : statsBinWidth(std::string(name) + ".statsBinWidth", sc_core::sc_time(1, sc_core::SC_US),
+                    "The initial width of a throughput bin", cci::CCI_ABSOLUTE_NAME)
+    , statsBins(std::string(name) + ".statsBins", 256, "The number of throughput bins, the bin width doubles if they are exhausted",
+                cci::CCI_ABSOLUTE_NAME)
+    , fw_port(fw_port)
+    , bw_port(bw_port)
+    , stats_name(name) {
+        tlm_stats_registry::get().add(this);
+    }
+
+    tlm_stats(tlm_stats const&) = delete;
+
+    tlm_stats& operator=(tlm_stats const&) = delete;
+
+    ~tlm_stats() override { tlm_stats_registry::get().remove(this); }
+
+    std::string const& get_stats_name() const override { return stats_name; }
+
+    void b_transport(payload_type& trans, sc_core::sc_time& delay) override {
+        auto start = sc_core::sc_time_stamp() + delay;
+        update_outstanding(1);
+        fw_port->b_transport(trans, delay);
+        update_outstanding(-1);
+        record(trans, start, sc_core::sc_time_stamp() + delay);
+    }
+
+    tlm::tlm_sync_enum nb_transport_fw(payload_type& trans, phase_type& phase, sc_core::sc_time& delay) override {
+        if(phase == tlm::BEGIN_REQ) {
+            pending[&trans] = sc_core::sc_time_stamp() + delay;
+            update_outstanding(1);
+        }
+        auto status = fw_port->nb_transport_fw(trans, phase, delay);
+        if(status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::BEGIN_RESP))
+            complete(trans, sc_core::sc_time_stamp() + delay);
+        return status;
+    }
+
+    tlm::tlm_sync_enum nb_transport_bw(payload_type& trans, phase_type& phase, sc_core::sc_time& delay) override {
+        if(phase == tlm::BEGIN_RESP)
+            complete(trans, sc_core::sc_time_stamp() + delay);
+        return bw_port->nb_transport_bw(trans, phase, delay);
+    }
+
+    bool get_direct_mem_ptr(payload_type& trans, tlm::tlm_dmi& dmi_data) override { return fw_port->get_direct_mem_ptr(trans, dmi_data); }
+
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_addr, sc_dt::uint64 end_addr) override {
+        bw_port->invalidate_direct_mem_ptr(start_addr, end_addr);
+    }
+
+    unsigned int transport_dbg(payload_type& trans) override { return fw_port->transport_dbg(trans); }
+    //! \brief the latency histogram of a command in units of the SystemC time resolution
+    util::hdr_histogram<> const& get_latencies(tlm::tlm_command cmd) const { return latencies[cmd]; }
+    //! \brief the maximum number of outstanding transactions
+    unsigned get_max_outstanding() const { return max_outstanding; }
+    //! \brief the time weighted average number of outstanding transactions up to now
+    double get_avg_outstanding() const {
+        auto now = sc_core::sc_time_stamp().value();
+        return now ? (outstanding_integral + static_cast<double>(outstanding) * (now - last_change)) / now : 0.;
+    }
+
+    void write_json(std::ostream& os) const override {
+        static char const* cmd_names[] = {"READ", "WRITE", "IGNORE"};
+        os << "{\"stream\": \"" << stats_name << "\", \"outstanding\": {\"max\": " << max_outstanding
+           << ", \"average\": " << get_avg_outstanding() << "}, \"latency_ns\": {";
+        for(auto i = 0U; i < latencies.size(); ++i) {
+            auto& h = latencies[i];
+            os << (i ? ", \"" : "\"") << cmd_names[i] << "\": {\"count\": " << h.count() << ", \"min\": " << to_ns(h.min())
+               << ", \"mean\": " << to_ns(h.mean()) << ", \"p50\": " << to_ns(h.value_at_percentile(50))
+               << ", \"p90\": " << to_ns(h.value_at_percentile(90)) << ", \"p99\": " << to_ns(h.value_at_percentile(99))
+               << ", \"max\": " << to_ns(h.max()) << "}";
+        }
+        os << "}, \"response_status\": {";
+        for(auto i = 0U; i < resp_counts.size(); ++i)
+            os << (i ? ", \"" : "\"") << resp_name(i) << "\": " << resp_counts[i];
+        os << "}, \"throughput\": {\"bin_width_ns\": " << to_ns(bin_width);
+        write_json_bins(os, "read_bytes", rd_bins);
+        write_json_bins(os, "write_bytes", wr_bins);
+        os << "}}";
+    }
+
+    void write_csv(std::ostream& os) const override {
+        static char const* cmd_names[] = {"READ", "WRITE", "IGNORE"};
+        os << stats_name << ",outstanding,max," << max_outstanding << "\n";
+        os << stats_name << ",outstanding,average," << get_avg_outstanding() << "\n";
+        for(auto i = 0U; i < latencies.size(); ++i) {
+            auto& h = latencies[i];
+            auto prefix = stats_name + ",latency_ns," + cmd_names[i];
+            os << prefix << ".count," << h.count() << "\n";
+            os << prefix << ".min," << to_ns(h.min()) << "\n";
+            os << prefix << ".mean," << to_ns(h.mean()) << "\n";
+            os << prefix << ".p50," << to_ns(h.value_at_percentile(50)) << "\n";
+            os << prefix << ".p90," << to_ns(h.value_at_percentile(90)) << "\n";
+            os << prefix << ".p99," << to_ns(h.value_at_percentile(99)) << "\n";
+            os << prefix << ".max," << to_ns(h.max()) << "\n";
+        }
+        for(auto i = 0U; i < resp_counts.size(); ++i)
+            os << stats_name << ",response_status," << resp_name(i) << "," << resp_counts[i] << "\n";
+        os << stats_name << ",throughput,bin_width_ns," << to_ns(bin_width) << "\n";
+        for(auto i = 0U; i < used_bins(); ++i) {
+            os << stats_name << ",throughput,read_bytes." << i << "," << (i < rd_bins.size() ? rd_bins[i] : 0) << "\n";
+            os << stats_name << ",throughput,write_bytes." << i << "," << (i < wr_bins.size() ? wr_bins[i] : 0) << "\n";
+        }
+    }
+
+private:
+    static double to_ns(double v) { return v * sc_core::sc_get_time_resolution().to_seconds() * 1e9; }
+
+    static char const* resp_name(unsigned idx) {
+        static char const* names[] = {"TLM_OK_RESPONSE",      "TLM_INCOMPLETE_RESPONSE", "TLM_GENERIC_ERROR_RESPONSE",
+                                      "TLM_ADDRESS_ERROR_RESPONSE", "TLM_COMMAND_ERROR_RESPONSE", "TLM_BURST_ERROR_RESPONSE",
+                                      "TLM_BYTE_ENABLE_ERROR_RESPONSE"};
+        return names[idx];
+    }
+
+    void update_outstanding(int diff) {
+        auto now = sc_core::sc_time_stamp().value();
+        outstanding_integral += static_cast<double>(outstanding) * (now - last_change);
+        last_change = now;
+        outstanding += diff;
+        max_outstanding = std::max(max_outstanding, outstanding);
+    }
+
+    void complete(payload_type& trans, sc_core::sc_time const& end) {
+        auto it = pending.find(&trans);
+        if(it == pending.end())
+            return;
+        auto start = it->second;
+        pending.erase(it);
+        update_outstanding(-1);
+        record(trans, start, end);
+    }
+
+    void record(payload_type& trans, sc_core::sc_time const& start, sc_core::sc_time const& end) {
+        auto cmd = std::min<unsigned>(trans.get_command(), tlm::TLM_IGNORE_COMMAND);
+        latencies[cmd].record(end > start ? (end - start).value() : 0);
+        resp_counts[std::min<unsigned>(1 - trans.get_response_status(), resp_counts.size() - 1)]++;
+        if(cmd == tlm::TLM_IGNORE_COMMAND)
+            return;
+        if(!bin_width) {
+            bin_width = std::max<uint64_t>(statsBinWidth.get_value().value(), 1);
+            rd_bins.assign(std::max(statsBins.get_value(), 2U), 0);
+            wr_bins.assign(rd_bins.size(), 0);
+        }
+        auto idx = start.value() / bin_width;
+        while(idx >= rd_bins.size()) {
+            coarsen(rd_bins);
+            coarsen(wr_bins);
+            bin_width *= 2;
+            idx /= 2;
+        }
+        (cmd == tlm::TLM_READ_COMMAND ? rd_bins : wr_bins)[idx] += trans.get_data_length();
+    }
+
+    static void coarsen(std::vector<uint64_t>& bins) {
+        auto half = bins.size() / 2;
+        for(size_t i = 0; i < half; ++i)
+            bins[i] = bins[2 * i] + bins[2 * i + 1];
+        if(bins.size() & 1) // an odd number of bins leaves the last one which starts the upper half
+            bins[half++] = bins.back();
+        std::fill(bins.begin() + half, bins.end(), 0);
+    }
+
+    size_t used_bins() const {
+        size_t n = rd_bins.size();
+        while(n && !rd_bins[n - 1] && !wr_bins[n - 1])
+            --n;
+        return n;
+    }
+
+    void write_json_bins(std::ostream& os, char const* name, std::vector<uint64_t> const& bins) const {
+        os << ", \"" << name << "\": [";
+        for(size_t i = 0, n = used_bins(); i < n; ++i)
+            os << (i ? ", " : "") << bins[i];
+        os << "]";
+    }
+
+    std::string const stats_name;
+    std::array<util::hdr_histogram<>, 3> latencies;
+    std::array<uint64_t, 7> resp_counts{};
+    std::unordered_map<payload_type*, sc_core::sc_time> pending;
+    unsigned outstanding{0}, max_outstanding{0};
+    uint64_t last_change{0};
+    double outstanding_integral{0.};
+    uint64_t bin_width{0};
+    std::vector<uint64_t> rd_bins, wr_bins;
+};
+/**
+ * @brief a module collecting the statistics of the transactions passing through, to be bound between an initiator
+ * and a target socket
+ */
+template <unsigned int BUSWIDTH = 32, typename TYPES = tlm::tlm_base_protocol_types, int N = 1,
+          sc_core::sc_port_policy POL = sc_core::SC_ONE_OR_MORE_BOUND>
+class tlm_stats_module : public sc_core::sc_module {
+public:
+    //! The target socket of the collector to be bound to the initiator
+    tlm::tlm_target_socket<BUSWIDTH, TYPES, N, POL> ts{"ts"};
+    //! The initiator to be bound to the target socket
+    tlm::tlm_initiator_socket<BUSWIDTH, TYPES, N, POL> is{"is"};
+
+    tlm_stats_module(sc_core::sc_module_name nm)
+    : sc_core::sc_module(nm)
+    , stats(name(), is.get_base_port(), ts.get_base_port()) {
+        is.bind(stats);
+        ts.bind(stats);
+    }
+
+    tlm_stats<TYPES> stats;
+
+private:
+    void end_of_simulation() override { tlm_stats_registry::get().dump(); }
+};
+/**
+ * @brief a drop-in replacement of the lwtr recorder module tlm::scc::lwtr::tlm2_lwtr_recorder collecting statistics
+ * instead of recording the transactions
+ */
+template <unsigned int BUSWIDTH = 32, typename TYPES = tlm::tlm_base_protocol_types, int N = 1,
+          sc_core::sc_port_policy POL = sc_core::SC_ONE_OR_MORE_BOUND>
+using tlm_stats_recorder = tlm_stats_module<BUSWIDTH, TYPES, N, POL>;
+} // namespace scc
+} // namespace tlm
+#endif /* _TLM_SCC_TLM_STATS_H_ */
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _TLM_SCC_TLM_STATS_SOCKETS_H_
+#define _TLM_SCC_TLM_STATS_SOCKETS_H_
+
+#include <tlm/scc/tlm_stats.h>
+#include <tlm>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+/**
+ * @brief an initiator socket collecting transaction statistics, drop-in replacement of the tlm_rec_initiator_socket
+ */
+template <unsigned int BUSWIDTH = 32, typename TYPES = tlm::tlm_base_protocol_types, int N = 1,
+          sc_core::sc_port_policy POL = sc_core::SC_ONE_OR_MORE_BOUND>
+class tlm_stats_initiator_socket : public tlm::tlm_initiator_socket<BUSWIDTH, TYPES, N, POL> {
+public:
+    using fw_interface_type = tlm::tlm_fw_transport_if<TYPES>;
+    using bw_interface_type = tlm::tlm_bw_transport_if<TYPES>;
+    using port_type = sc_core::sc_port<fw_interface_type, N, POL>;
+    using export_type = sc_core::sc_export<bw_interface_type>;
+    using base_target_socket_type = tlm::tlm_base_target_socket_b<BUSWIDTH, fw_interface_type, bw_interface_type>;
+    using base_type = tlm::tlm_base_initiator_socket_b<BUSWIDTH, fw_interface_type, bw_interface_type>;
+
+    tlm_stats_initiator_socket()
+    : tlm::tlm_initiator_socket<BUSWIDTH, TYPES, N, POL>()
+    , stats(this->name(), fw_port, bw_port) {}
+
+    explicit tlm_stats_initiator_socket(const char* name)
+    : tlm::tlm_initiator_socket<BUSWIDTH, TYPES, N, POL>(name)
+    , stats(this->name(), fw_port, bw_port) {}
+
+    virtual ~tlm_stats_initiator_socket() = default;
+
+    const char* kind() const override { return "tlm_stats_initiator_socket"; }
+    //
+    // Bind initiator socket to target socket
+    // - Binds the port of the initiator socket to the export of the target
+    //   socket
+    // - Binds the port of the target socket to the export of the initiator
+    //   socket
+    //
+    void bind(base_target_socket_type& s) override {
+        // initiator.port -> target.export
+        (this->get_base_port())(stats);
+        fw_port(s.get_base_interface());
+        // target.port -> initiator.export
+        (s.get_base_port())(stats);
+        bw_port(this->get_base_interface());
+    }
+    //
+    // Bind initiator socket to initiator socket (hierarchical bind)
+    // - Binds both the export and the port
+    //
+    void bind(base_type& s) override {
+        // port
+        (this->get_base_port())(stats);
+        fw_port(s.get_base_port());
+        // export
+        (s.get_base_export())(stats);
+        bw_port(this->get_base_export());
+    }
+    //
+    // Bind interface to socket
+    // - Binds the interface to the export of this socket
+    //
+    void bind(bw_interface_type& ifs) override { (this->get_base_export())(ifs); }
+    //! \brief the statistics collector of this socket
+    tlm_stats<TYPES> const& get_stats() const { return stats; }
+
+protected:
+    void end_of_simulation() override { tlm_stats_registry::get().dump(); }
+
+    sc_core::sc_port<tlm::tlm_fw_transport_if<TYPES>> fw_port{sc_core::sc_gen_unique_name("$$$__stats_fw__$$$")};
+    sc_core::sc_port<tlm::tlm_bw_transport_if<TYPES>> bw_port{sc_core::sc_gen_unique_name("$$$__stats_bw__$$$")};
+    tlm_stats<TYPES> stats;
+};
+/**
+ * @brief a target socket collecting transaction statistics, drop-in replacement of the tlm_rec_target_socket
+ */
+template <unsigned int BUSWIDTH = 32, typename TYPES = tlm::tlm_base_protocol_types, int N = 1,
+          sc_core::sc_port_policy POL = sc_core::SC_ONE_OR_MORE_BOUND>
+class tlm_stats_target_socket : public tlm::tlm_target_socket<BUSWIDTH, TYPES, N, POL> {
+public:
+    using fw_interface_type = tlm::tlm_fw_transport_if<TYPES>;
+    using bw_interface_type = tlm::tlm_bw_transport_if<TYPES>;
+    using port_type = sc_core::sc_port<bw_interface_type, N, POL>;
+    using export_type = sc_core::sc_export<fw_interface_type>;
+    using base_initiator_socket_type = tlm::tlm_base_initiator_socket_b<BUSWIDTH, fw_interface_type, bw_interface_type>;
+    using base_type = tlm::tlm_base_target_socket_b<BUSWIDTH, fw_interface_type, bw_interface_type>;
+
+    tlm_stats_target_socket()
+    : tlm::tlm_target_socket<BUSWIDTH, TYPES, N, POL>()
+    , stats(this->name(), fw_port, this->get_base_port()) {}
+
+    explicit tlm_stats_target_socket(const char* name)
+    : tlm::tlm_target_socket<BUSWIDTH, TYPES, N, POL>(name)
+    , stats(this->name(), fw_port, this->get_base_port()) {}
+
+    virtual ~tlm_stats_target_socket() = default;
+
+    const char* kind() const override { return "tlm_stats_target_socket"; }
+    //
+    // Bind target socket to target socket (hierarchical bind)
+    // - Binds both the export and the port
+    //
+    void bind(base_type& s) override {
+        // export
+        (this->get_base_export())(s.get_base_export());
+        // port
+        (s.get_base_port())(stats);
+    }
+    //
+    // Bind interface to socket
+    // - Binds the interface to the export
+    //
+    void bind(fw_interface_type& ifs) override {
+        export_type* exp = &this->get_base_export();
+        if(this == exp) {
+            export_type::bind(stats); // non-virtual function call
+            fw_port(ifs);
+        } else {
+            exp->bind(ifs);
+        }
+    }
+    //
+    // Forward to 'operator->()' of port class
+    //
+    bw_interface_type* operator->() { return &stats; }
+    //! \brief the statistics collector of this socket
+    tlm_stats<TYPES> const& get_stats() const { return stats; }
+
+protected:
+    void end_of_simulation() override { tlm_stats_registry::get().dump(); }
+
+    sc_core::sc_port<fw_interface_type> fw_port{sc_core::sc_gen_unique_name("$$$__stats_fw__$$$")};
+    tlm_stats<TYPES> stats;
+};
+} // namespace scc
+} // namespace tlm
+#endif /* _TLM_SCC_TLM_STATS_SOCKETS_H_ */
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ * Copyright 2024 MINRES Technologies GmbH
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *******************************************************************************/
+
+#ifndef _TLM_SCC_TX_RECORDING_POLICY_H_
+#define _TLM_SCC_TX_RECORDING_POLICY_H_
+
+#include <algorithm>
+#include <cci_configuration>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sysc/kernel/sc_dynamic_processes.h>
+#include <sysc/kernel/sc_simcontext.h>
+#include <sysc/utils/sc_report_handler.h>
+
+//! @brief SystemC TLM
+namespace tlm {
+//! @brief SCC TLM utilities
+namespace scc {
+/**
+ * @brief front-end policy deciding which transactions a recorder writes into the database
+ *
+ * The policy combines
+ * - a recording time window [recStartTime, recEndTime),
+ * - a sampling ratio where only every n-th transaction is recorded,
+ * - a trigger which needs to fire before recording starts (see trigger() and trigger_on()),
+ * - an error window: transactions are only kept in a bounded ring buffer and written to the database once an
+ *   error is reported. In this case the transactions within the error window before the report and all transactions
+ *   within the error window after the report are recorded.
+ *
+ * All settings are CCI parameters which can be changed at any time during simulation. Their values are mirrored
+ * into plain members by post-write callbacks so that the per-transaction decision does not involve the broker.
+ *
+ * In error window mode the buffered transactions are written (see set_flush_callback()) as soon as an error is
+ * reported. For this a report handler is chained once in front of the handler installed at the start of simulation.
+ * If the handler is replaced later on, new errors are still detected by their count upon the next transaction.
+ */
+class tx_recording_policy {
+public:
+    enum decision { SKIP, RECORD, BUFFER };
+    //! \brief the time at which recording starts
+    cci::cci_param<sc_core::sc_time> recStartTime;
+    //! \brief the time at which recording ends, SC_ZERO_TIME means never
+    cci::cci_param<sc_core::sc_time> recEndTime;
+    //! \brief record only every n-th transaction
+    cci::cci_param<unsigned> recSamplingRatio;
+    //! \brief if set recording starts only after the trigger fired
+    cci::cci_param<bool> recWaitForTrigger;
+    //! \brief if non-zero transactions are only recorded in this window around an error report
+    cci::cci_param<sc_core::sc_time> recErrorWindow;
+    //! \brief the maximum number of transactions kept while waiting for an error report
+    cci::cci_param<unsigned> recErrorBufferSize;
+    /**
+     * @brief constructs the policy and its parameters
+     *
+     * @param basename the hierarchical name the parameter names are derived from
+     */
+    explicit tx_recording_policy(std::string const& basename)
+    : recStartTime(basename + ".recStartTime", sc_core::SC_ZERO_TIME, "Simulation time when transaction recording starts",
+                   cci::CCI_ABSOLUTE_NAME)
+    , recEndTime(basename + ".recEndTime", sc_core::SC_ZERO_TIME,
+                 "Simulation time when transaction recording ends, a value of 0 means recording never ends", cci::CCI_ABSOLUTE_NAME)
+    , recSamplingRatio(basename + ".recSamplingRatio", 1, "Record only every n-th transaction", cci::CCI_ABSOLUTE_NAME)
+    , recWaitForTrigger(basename + ".recWaitForTrigger", false, "Start recording only after the trigger event fired",
+                        cci::CCI_ABSOLUTE_NAME)
+    , recErrorWindow(basename + ".recErrorWindow", sc_core::SC_ZERO_TIME,
+                     "If non-zero transactions are buffered and only recorded within this window before and after an error report",
+                     cci::CCI_ABSOLUTE_NAME)
+    , recErrorBufferSize(basename + ".recErrorBufferSize", 4096, "The maximum number of transactions buffered for the error window",
+                         cci::CCI_ABSOLUTE_NAME) {
+        recStartTime.register_post_write_callback(
+            [this](cci::cci_param_write_event<sc_core::sc_time> const&) { update(); });
+        recEndTime.register_post_write_callback(
+            [this](cci::cci_param_write_event<sc_core::sc_time> const&) { update(); });
+        recSamplingRatio.register_post_write_callback(
+            [this](cci::cci_param_write_event<unsigned> const&) { update(); });
+        recWaitForTrigger.register_post_write_callback(
+            [this](cci::cci_param_write_event<bool> const&) { update(); });
+        recErrorWindow.register_post_write_callback(
+            [this](cci::cci_param_write_event<sc_core::sc_time> const&) { update(); });
+        recErrorBufferSize.register_post_write_callback(
+            [this](cci::cci_param_write_event<unsigned> const&) { update(); });
+        update();
+    }
+
+    tx_recording_policy(tx_recording_policy const&) = delete;
+
+    tx_recording_policy& operator=(tx_recording_policy const&) = delete;
+
+    ~tx_recording_policy() { error_registry::get().remove(this); }
+    /**
+     * @brief check if any of the policies is active. If not each transaction is recorded
+     *
+     * @return true if transactions are filtered
+     */
+    inline bool is_active() const { return active; }
+    /**
+     * @brief decide how to handle the transaction starting at the current simulation time
+     *
+     * @return SKIP if the transaction shall not be recorded, BUFFER if it shall be kept for a possible error report
+     * and RECORD if it shall be written to the database
+     */
+    inline decision decide() {
+        if(!active)
+            return RECORD;
+        if(wait_for_trigger && !triggered)
+            return SKIP;
+        auto now = sc_core::sc_time_stamp();
+        if(now < start_time || (end_time > sc_core::SC_ZERO_TIME && now >= end_time))
+            return SKIP;
+        if(sampling_ratio > 1 && (sample_cnt++ % sampling_ratio))
+            return SKIP;
+        if(error_window > sc_core::SC_ZERO_TIME) {
+            check_errors();
+            return now < record_until ? RECORD : BUFFER;
+        }
+        return RECORD;
+    }
+    /**
+     * @brief decide how to handle a follow-up part of a transaction which has been accepted by decide()
+     *
+     * @return RECORD or BUFFER depending on the error window state
+     */
+    inline decision current() {
+        if(error_window > sc_core::SC_ZERO_TIME) {
+            check_errors();
+            return sc_core::sc_time_stamp() < record_until ? RECORD : BUFFER;
+        }
+        return RECORD;
+    }
+    /**
+     * @brief returns true once after a new error has been reported while running in error window mode. The recorder
+     * then needs to write its buffered transactions
+     */
+    inline bool flush_requested() {
+        if(error_window == sc_core::SC_ZERO_TIME)
+            return false;
+        check_errors();
+        auto ret = flush_pending;
+        flush_pending = false;
+        return ret;
+    }
+    /**
+     * @brief sets the functor writing the buffered transactions. It is called from within the report handler once an
+     * error is reported while running in error window mode
+     *
+     * @param cb the functor
+     */
+    void set_flush_callback(std::function<void()> cb) {
+        flush_cb = std::move(cb);
+        error_registry::get().add(this);
+    }
+    //! \brief the size of the error window
+    inline sc_core::sc_time const& get_error_window() const { return error_window; }
+    //! \brief the maximum number of buffered transactions
+    inline size_t get_error_buffer_size() const { return error_buffer_size; }
+    //! \brief starts recording if recWaitForTrigger is set
+    void trigger() { triggered = true; }
+    //! \brief stops recording if recWaitForTrigger is set until the next trigger
+    void reset_trigger() { triggered = false; }
+    /**
+     * @brief starts recording once the given event fires
+     *
+     * The event needs to be notified after the start of elaboration as this spawns a method process.
+     * @param evt the trigger event
+     */
+    void trigger_on(sc_core::sc_event const& evt) {
+        sc_core::sc_spawn_options opts;
+        opts.spawn_method();
+        opts.dont_initialize();
+        opts.set_sensitivity(&evt);
+        sc_core::sc_spawn([this]() { trigger(); }, nullptr, &opts);
+    }
+
+private:
+    void update() {
+        start_time = recStartTime.get_value();
+        end_time = recEndTime.get_value();
+        sampling_ratio = recSamplingRatio.get_value();
+        wait_for_trigger = recWaitForTrigger.get_value();
+        error_window = recErrorWindow.get_value();
+        error_buffer_size = recErrorBufferSize.get_value();
+        active = start_time > sc_core::SC_ZERO_TIME || end_time > sc_core::SC_ZERO_TIME || sampling_ratio > 1 || wait_for_trigger ||
+                 error_window > sc_core::SC_ZERO_TIME;
+    }
+    //! \brief called by the report handler for errors and fatals, the report is already counted
+    void on_error() {
+        if(error_window == sc_core::SC_ZERO_TIME || !flush_cb)
+            return;
+        check_errors();
+        if(flush_pending) {
+            flush_pending = false;
+            flush_cb();
+        }
+    }
+
+    /**
+     * the registry of the policies having a flush callback. It owns the report handler notifying them about errors,
+     * the handler is installed once at the start of simulation in front of the handler set up by then (e.g. by
+     * scc::init_logging()).
+     */
+    struct error_registry {
+        static error_registry& get() {
+            static error_registry inst;
+            return inst;
+        }
+
+        void add(tx_recording_policy* p) {
+            if(std::find(listeners.begin(), listeners.end(), p) == listeners.end())
+                listeners.push_back(p);
+            if(!install_scheduled) {
+                install_scheduled = true;
+                sc_core::sc_spawn_options opts;
+                opts.spawn_method();
+                sc_core::sc_spawn([this]() { install(); }, nullptr, &opts);
+            }
+        }
+
+        void remove(tx_recording_policy* p) { listeners.erase(std::remove(listeners.begin(), listeners.end(), p), listeners.end()); }
+
+    private:
+        void install() {
+            auto current = sc_core::sc_report_handler::get_handler();
+            if(current != &error_registry::report_handler) {
+                chained = current;
+                sc_core::sc_report_handler::set_handler(&error_registry::report_handler);
+            }
+        }
+
+        static void report_handler(sc_core::sc_report const& rep, sc_core::sc_actions const& actions) {
+            auto& reg = get();
+            if(rep.get_severity() == sc_core::SC_ERROR || rep.get_severity() == sc_core::SC_FATAL)
+                for(auto* p : reg.listeners)
+                    p->on_error();
+            if(reg.chained)
+                reg.chained(rep, actions);
+            else
+                sc_core::sc_report_handler::default_handler(rep, actions);
+        }
+
+        std::vector<tx_recording_policy*> listeners;
+        sc_core::sc_report_handler_proc chained{nullptr};
+        bool install_scheduled{false};
+    };
+
+    inline void check_errors() {
+        auto cnt = sc_core::sc_report_handler::get_count(sc_core::SC_ERROR) + sc_core::sc_report_handler::get_count(sc_core::SC_FATAL);
+        if(cnt != error_cnt) {
+            error_cnt = cnt;
+            record_until = sc_core::sc_time_stamp() + error_window;
+            flush_pending = true;
+        }
+    }
+
+    sc_core::sc_time start_time, end_time, error_window, record_until;
+    unsigned sampling_ratio{1};
+    size_t error_buffer_size{0};
+    uint64_t sample_cnt{0};
+    int error_cnt{0};
+    bool wait_for_trigger{false}, triggered{false}, active{false}, flush_pending{false};
+    std::function<void()> flush_cb;
+};
+/**
+ * @brief bounded buffer of transactions kept by a recorder while waiting for an error report
+ *
+ * Entries need to provide a member end_time denoting when the transaction finished.
+ */
+template <typename ENTRY> class tx_ring_buffer {
+public:
+    /**
+     * @brief add an entry and drop all entries which are older than the window or exceed the capacity
+     *
+     * @param e the entry
+     * @param window the time window to keep
+     * @param capacity the maximum number of entries
+     */
+    void push(ENTRY&& e, sc_core::sc_time const& window, size_t capacity) {
+        entries.emplace_back(std::move(e));
+        auto now = sc_core::sc_time_stamp();
+        while(entries.size() > capacity || (entries.size() && entries.front().end_time + window < now))
+            entries.pop_front();
+    }
+    /**
+     * @brief hands all buffered entries which finished within the window to the given functor and clears the buffer
+     *
+     * @param window the time window to report
+     * @param f the functor getting an ENTRY& as argument
+     */
+    template <typename FUNC> void flush(sc_core::sc_time const& window, FUNC f) {
+        auto now = sc_core::sc_time_stamp();
+        for(auto& e : entries)
+            if(e.end_time + window >= now)
+                f(e);
+        entries.clear();
+    }
+
+    bool empty() const { return entries.empty(); }
+
+private:
+    std::deque<ENTRY> entries;
+};
+} // namespace scc
+} // namespace tlm
+#endif /* _TLM_SCC_TX_RECORDING_POLICY_H_ */